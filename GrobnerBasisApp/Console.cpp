@@ -7,11 +7,16 @@ Date: 5/12/2022
 #include "LexTermOrder.h"
 #include "DegLexTermOrder.h"
 #include "DegRevLexTermOrder.h"
+#include "MatrixTermOrder.h"
+#include "MappedFile.h"
+#include "FileParser.h"
+#include <fstream>
+#include <set>
 
 //printed by the "help" command
 const std::string helpString =
 "\nSolves the ideal membership problem for polynomials in x,y,z with rational coefficients.\n"
-"Polynomials should be entered in standard form (1/2*x^2 + x*y + 1/2*y^2, not 1/2*(x+y)^2).\n\n"
+"Polynomials may use +, -, *, ^, parentheses, and division by numbers, such as 1/2*(x+y)^2 - x*y.\n\n"
 "COMMANDS:\n\n"
 "help\n"
 "Display this help menu.\n\n"
@@ -20,20 +25,86 @@ const std::string helpString =
 "Example:\n"
 ">>ideal x^2*y - x + 1, -y^2*z + 1/3*x^3\n"
 "I := ( y*x^2 - x + 1 , z*y^2 - 1/3*x^3 , x^5 - 3*z*y*x + 3 * z * y )\n\n"
-"member POLY\n"
-"Print true if POLY is in the ideal. Otherwise, print false.\n"
+"ideal load FILE\n"
+"Set the generators of the ideal to the polynomials in FILE, separated by commas or newlines,\n"
+"and print its Grobner basis. Errors are reported with the line and column in FILE.\n\n"
+"extend POLY1,POLY2,...\n"
+"Add generators to the ideal and print its Grobner basis. Faster than ideal with the\n"
+"whole list, since the current basis is kept and only updated.\n"
+"Example:\n"
+">>ideal x^2 - y\n"
+"I := ( y - x^2 )\n"
+">>extend x*y - 1\n"
+"I := ( y - x^2 , x^3 - 1 )\n\n"
+"member POLY1,POLY2,...\n"
+"Print true if POLY is in the ideal. Otherwise, print false. Given several polynomials,\n"
+"print one answer per line.\n"
 "Example:\n"
 ">>member x^5 - 3*z*y*x + 3 * z * y\n"
 "true\n\n"
-"reduce POLY\n"
-"Print the reduction of POLY by the ideal.\n"
+"memberof POLY : POLY1,POLY2,...\n"
+"Print true if POLY is in the ideal generated by POLY1,POLY2,... . Faster than ideal\n"
+"followed by member for a single question, since the basis is only finished if needed.\n"
+"The current ideal is unchanged.\n"
+"Example:\n"
+">>memberof x^5 - 3*z*y*x + 3 * z * y : x^2*y - x + 1, -y^2*z + 1/3*x^3\n"
+"true\n\n"
+"reduce POLY1,POLY2,...\n"
+"Print the reduction of POLY by the ideal, one line per polynomial.\n"
 "Example:\n"
 ">>reduce y^2*x^3\n"
 "-y*x + x - 1\n\n"
 "termorder NAME\n"
-"Sets the term order to use. Options are lex, deglex, and degrevlex.\n\n"
+"Sets the term order to use. Options are lex, deglex, degrevlex, and weight W1,W2,...\n"
+"which compares by the weights W1,W2,... of the variables in the order z,y,x, breaking ties\n"
+"with lex. matrix W1,W2,...;V1,V2,...;... breaks ties by each further row of weights in turn.\n"
+"The basis is converted to the new order rather than recomputed where possible.\n\n"
+"hilbert N\n"
+"Prints the Hilbert series of the ideal, the values of its Hilbert function at degrees 0 to N-1\n"
+"(default 10), and the dimension and degree of the quotient ring. For an ideal that is not\n"
+"homogeneous they are those of the ideal of the leading terms of the basis. Changing the term\n"
+"order of a homogeneous ideal uses its Hilbert series to skip most of the work.\n"
+"Example:\n"
+">>ideal x^2 - y*z, y^3 - z^3\n"
+"I := ( z^3 - y^3 , z^2*x^2 - y^4 , z*y - x^2 , z*x^4 - y^5 , y^6 - x^6 )\n"
+">>hilbert 5\n"
+"H(t) = (1 - t^2 - t^3 + t^5)/(1-t)^3\n"
+"Hilbert function: 1, 3, 5, 6, 6\n"
+"Dimension 1, degree 6\n\n"
+"save FILE\n"
+"Writes the Grobner basis and term order to FILE in a compact binary format.\n\n"
+"open FILE\n"
+"Reads a Grobner basis and term order written by save, ready to use without recomputing.\n\n"
+"status\n"
+"ideal, extend and termorder compute in the background when they take more than a moment,\n"
+"while member, reduce and the rest answer for the previous ideal. The result is printed after\n"
+"the next command once it is ready. status prints the progress: the phase, the critical pairs\n"
+"left and reduced, and the basis size so far.\n\n"
+"cancel\n"
+"Stops the computation in the background, keeping the previous ideal.\n\n"
+"wait\n"
+"Waits for the computation in the background and prints its result.\n\n"
+"threads N\n"
+"Sets the number of threads used to compute Grobner bases (0 for all hardware threads).\n\n"
+"cache DIRECTORY\n"
+"Keeps computed Grobner bases in DIRECTORY, which may be shared by other sessions, and looks\n"
+"them up there before computing. \"cache off\" stops using it.\n\n"
+"stats\n"
+"Prints the work done computing Grobner bases since startup or \"stats reset\": critical pairs,\n"
+"reduction steps, the largest basis, element, and coefficient, the time in each phase, and, if\n"
+"it is counted, the memory in use and at peak for the basis, the critical pairs, and temporary\n"
+"polynomials. \"stats off\" and \"stats on\" stop and resume collecting them.\n\n"
+"memory on\n"
+"Counts the memory used computing Grobner bases, which \"stats\" prints; it is always counted\n"
+"under a memory limit. \"memory off\" stops counting it.\n\n"
+"memlimit MEGABYTES\n"
+"Stops computing a Grobner basis that needs more memory than MEGABYTES, with an error, keeping\n"
+"the ideal as it was. \"memlimit off\" removes the limit.\n\n"
+"trace on FILE\n"
+"Records the time spent in each step of computing Grobner bases to FILE, in the Chrome trace\n"
+"event format, which chrome://tracing and ui.perfetto.dev display. \"trace off\" finishes FILE.\n\n"
 "quit\n"
-"Quits the application.\n\n";
+"Quits the application, cancelling any computation in the background.\n\n";
 
 //prints at startup
 const std::string headerString =
@@ -41,6 +112,12 @@ const std::string headerString =
 "Enter \"help\" for instructions, or \"quit\" to exit.\n>>"; //includes >> prompt
 
 
+Console::~Console()
+{
+	if (mJob)
+		mJob->budget->cancel(); //then waited for as it is destroyed
+}
+
 std::string Console::header()
 {
 	return headerString;
@@ -54,46 +131,118 @@ std::string Console::dispatchCommand(const std::string& commandLine)
 
 	std::string command;
 	input >> command; //get the first token, the name of the command
+	mFailed = false;
+
+	//report a computation that has ended since the last command
+	finishJob(output, std::chrono::steady_clock::duration::zero());
 
-	if (command == "quit")
+	//these change the ideal or its settings, which the computation in the background has copied
+	static const std::set<std::string> changing{ "ideal", "extend", "termorder", "open", "threads", "cache",
+		"trace", "memory", "memlimit" };
+	if (mJob && changing.count(command))
+		fail(output) << "Error: a basis is being computed; \"wait\" for it or \"cancel\" it first\n";
+	else if (command == "quit")
+	{
+		if (mJob)
+		{
+			mJob->budget->cancel();
+			finishJob(output);
+		}
 		mQuit = true;
+	}
 	else if (command == "ideal")
 		setIdeal(input, output);
+	else if (command == "extend")
+		extendIdeal(input, output);
 	else if (command == "member")
 		isMember(input, output);
+	else if (command == "memberof")
+		isMemberOf(input, output);
 	else if (command == "reduce")
 		reduce(input, output);
 	else if (command == "help")
 		output << helpString;
 	else if (command == "termorder")
 		setTermOrder(input, output);
+	else if (command == "threads")
+		setThreadCount(input, output);
+	else if (command == "cache")
+		setCache(input, output);
+	else if (command == "hilbert")
+		showHilbertSeries(input, output);
+	else if (command == "save")
+		saveBasis(input, output);
+	else if (command == "open")
+		openBasis(input, output);
+	else if (command == "stats")
+		showStatistics(input, output);
+	else if (command == "trace")
+		setTrace(input, output);
+	else if (command == "memory")
+		setMemoryCounting(input, output);
+	else if (command == "memlimit")
+		setMemoryLimit(input, output);
+	else if (command == "status")
+		showStatus(input, output);
+	else if (command == "cancel")
+		cancelJob(input, output);
+	else if (command == "wait")
+		waitForJob(input, output);
 	else if (command != "") //if blank, do nothing
-		output << "Unknown command " << command << "\n";
+		fail(output) << "Unknown command " << command << "\n";
 
-	if (!mQuit) 
+	if (!mQuit && mInteractive)
 		output << ">>";
 	return output.str();
 }
 
+std::ostream& Console::fail(std::ostream& output)
+{
+	mFailed = true;
+	return output;
+}
+
 void Console::setIdeal(std::istream& input, std::ostream& output)
 {
 	try
 	{
-		std::vector<Polynomial<Rational<int>>> gens; //generators of the ideal
-
-		//read the comma-separated list of polynomials
-		for (std::string polyString; std::getline(input, polyString, ',');)
-			gens.push_back(mParser.parse(polyString)); 
+		std::vector<Polynomial<Rational<int>>> gens;
+		std::string word;
+		auto start = input.tellg();
+		if (input >> word && word == "load") //generators from a file
+		{
+			std::string fileName;
+			std::getline(input >> std::ws, fileName);
+			gens = FileParser<Polynomial<Rational<int>>>(mParser, mIdeal.threadPool()).parse(fileName);
+		}
+		else
+		{
+			input.clear();
+			input.seekg(start);
+			gens = parseList(input, true); //generators of the ideal; none for the zero ideal
+		}
 
-		//set the ideal
-		mIdeal = { gens.begin(), gens.end() };
+		//set the ideal, keeping the term order and thread count
+		startJob("ideal", mTermOrderName, [gens = std::move(gens)](Ideal<Rational<>>& ideal)
+			{ ideal.setGenerators(gens.begin(), gens.end()); }, output);
+	}
+	catch (std::exception& ex)
+	{
+		fail(output) << "Error: " << ex.what() << "\n"; 
+	}
+}
 
-		//print back the ideal as a Grobner basis
-		output << "I := " << mIdeal.toString(mPrinter) << "\n";
+void Console::extendIdeal(std::istream& input, std::ostream& output)
+{
+	try
+	{
+		auto gens = parseList(input, false); //the generators to add
+		startJob("extend", mTermOrderName, [gens = std::move(gens)](Ideal<Rational<>>& ideal)
+			{ ideal.addGenerators(gens.begin(), gens.end()); }, output);
 	}
 	catch (std::exception& ex)
 	{
-		output << "Error: " << ex.what() << "\n"; 
+		fail(output) << "Error: " << ex.what() << "\n";
 	}
 }
 
@@ -101,57 +250,441 @@ void Console::isMember(std::istream& input, std::ostream& output)
 {
 	try
 	{
-		std::string polyString;
-		std::getline(input, polyString); //get the rest of the line
-		output << mIdeal.isMember(mParser.parse(polyString)) << "\n"; //parse and answer
+		auto polys = parseList(input, false); //get the rest of the line
+		std::vector<char> answers;
+		mIdeal.isMemberAll(polys.begin(), polys.end(), std::back_inserter(answers)); //answer all at once
+		for (char answer : answers)
+			output << bool(answer) << "\n";
 	}
 	catch (std::exception& ex)
 	{
-		output << "Error: " << ex.what() << "\n";
+		fail(output) << "Error: " << ex.what() << "\n";
 	}
 }
+
 void Console::reduce(std::istream& input, std::ostream& output)
 {
 	try
 	{
-		std::string polyString;
-		std::getline(input, polyString); //get the rest of the line
-		output << mIdeal.reduce(mParser.parse(polyString)).toString(mPrinter) << "\n";//parse and answer
+		auto polys = parseList(input, false); //get the rest of the line
+		std::vector<Polynomial<Rational<int>>> remainders;
+		mIdeal.reduceAll(polys.begin(), polys.end(), std::back_inserter(remainders)); //answer all at once
+		for (const auto& remainder : remainders)
+		{
+			remainder.print(output, mPrinter);
+			output << "\n";
+		}
 	}
 	catch (std::exception& ex)
 	{
-		output << "Error: " << ex.what() << "\n";
+		fail(output) << "Error: " << ex.what() << "\n";
 	}
 }
 
+std::vector<Polynomial<Rational<int>>> Console::parseList(std::istream& input, bool allowEmpty) const
+{
+	std::vector<Polynomial<Rational<int>>> polys;
+	for (std::string polyString; std::getline(input, polyString, ',');)
+		polys.push_back(mParser.parse(polyString));
+	if (polys.empty() && !allowEmpty)
+		throw RationalParser::ParseException("expected a polynomial");
+	return polys;
+}
+
 void Console::setTermOrder(std::istream& input, std::ostream& output)
 {
 	try
 	{
 		std::string name;
-		input >> name;
-		if (name == "lex")
+		std::getline(input >> std::ws, name); //the rest of the line, for weights
+		auto termOrder = makeTermOrder(name);
+		if (termOrder)
+		{
+			startJob("termorder", name, [termOrder = std::move(termOrder)](Ideal<Rational<>>& ideal) mutable
+				{ ideal.setTermOrder(std::move(termOrder)); }, output);
+		}
+		else
+		{
+			fail(output) << "Unknown term order " << name << "\n";
+		}
+	}
+	catch (std::exception& ex)
+	{
+		fail(output) << "Error: " << ex.what() << "\n";
+	}
+}
+
+void Console::isMemberOf(std::istream& input, std::ostream& output)
+{
+	try
+	{
+		std::string polyString;
+		std::getline(input, polyString, ':'); //the polynomial comes before the colon
+		auto poly = mParser.parse(polyString);
+		auto gens = parseList(input, true); //the generators after it
+
+		output << Ideal<Rational<>>::isMemberOf(gens.begin(), gens.end(), poly, makeTermOrder(mTermOrderName)) << "\n";
+	}
+	catch (std::exception& ex)
+	{
+		fail(output) << "Error: " << ex.what() << "\n";
+	}
+}
+
+std::unique_ptr<PowerProduct::TermOrder> Console::makeTermOrder(const std::string& name)
+{
+	if (name == "lex")
+		return std::make_unique<LexTermOrder>();
+	else if (name == "deglex")
+		return std::make_unique<DegLexTermOrder>();
+	else if (name == "degrevlex")
+		return std::make_unique<DegRevLexTermOrder>();
+	else if (name.compare(0, 6, "weight") == 0 || name.compare(0, 6, "matrix") == 0)
+	{
+		//rows of comma-separated integers, separated by semicolons; weight has just one
+		std::istringstream rows(name.substr(6));
+		PowerProduct::TermOrder::Matrix matrix;
+		for (std::string rowString; std::getline(rows, rowString, ';');)
+		{
+			std::istringstream weights(rowString);
+			matrix.emplace_back();
+			for (std::string weight; std::getline(weights, weight, ',');)
+				matrix.back().push_back(std::stoll(weight));
+		}
+		if (name[0] == 'w' && matrix.size() != 1)
+			return nullptr;
+		return std::make_unique<MatrixTermOrder>(matrix);
+	}
+	else
+		return nullptr;
+}
+
+std::string Console::matrixName(const PowerProduct::TermOrder::Matrix& matrix)
+{
+	std::ostringstream name;
+	name << "matrix ";
+	for (size_t r = 0; r < matrix.size(); ++r)
+	{
+		for (size_t c = 0; c < matrix[r].size(); ++c)
+			name << (c == 0 ? "" : ",") << matrix[r][c];
+		if (r + 1 < matrix.size())
+			name << ";";
+	}
+	return name.str();
+}
+
+void Console::setThreadCount(std::istream& input, std::ostream& output)
+{
+	unsigned threads;
+	if (input >> threads)
+	{
+		mIdeal.setThreadCount(threads);
+		output << "Using " << mIdeal.threadCount() << " thread(s)\n";
+	}
+	else
+		fail(output) << "Error: expected a thread count\n";
+}
+
+void Console::setCache(std::istream& input, std::ostream& output)
+{
+	std::string directory;
+	std::getline(input >> std::ws, directory); //the rest of the line, which may contain spaces
+	if (directory.empty())
+		fail(output) << "Error: expected a directory\n";
+	else if (directory == "off")
+	{
+		mIdeal.setCache(nullptr);
+		output << "Not caching\n";
+	}
+	else
+	{
+		try
+		{
+			mIdeal.setCache(std::make_shared<BasisCache>(directory));
+			output << "Caching in " << directory << "\n";
+		}
+		catch (std::exception& ex)
+		{
+			fail(output) << "Error: " << ex.what() << "\n";
+		}
+	}
+}
+
+void Console::showStatistics(std::istream& input, std::ostream& output)
+{
+	std::string option;
+	input >> option;
+	if (!option.empty() && mJob)
+		fail(output) << "Error: a basis is being computed; \"wait\" for it or \"cancel\" it first\n";
+	else if (option == "reset")
+	{
+		mIdeal.resetStatistics();
+		output << "Statistics reset\n";
+	}
+	else if (option == "on" || option == "off")
+	{
+		mIdeal.setStatisticsEnabled(option == "on");
+		output << "Statistics " << option << "\n";
+	}
+	else if (!option.empty())
+		fail(output) << "Error: expected on, off, or reset\n";
+	else
+	{
+		const auto& stats = mIdeal.statistics();
+		output << "Critical pairs: " << stats.pairsCreated << " created, " << stats.pairsPruned << " pruned, "
+			<< stats.pairsSkipped << " skipped by the Hilbert series, "
+			<< stats.pairsReduced << " reduced (" << stats.zeroReductions << " to zero)\n"
+			<< "Reduction steps: " << stats.reductionSteps << "\n"
+			<< "Largest basis: " << stats.maxBasisSize << " elements\n"
+			<< "Largest element: " << stats.maxTerms << " terms\n"
+			<< "Largest coefficient: " << stats.maxCoefficientBits << " bits\n"
+			<< "Seconds: " << stats.computeSeconds << " computing, " << stats.minimizeSeconds
+			<< " minimizing, " << stats.reduceSeconds << " reducing\n";
+		const MemoryAccount& memory = mIdeal.memory();
+		auto kib = [](size_t bytes) { return (bytes + 1023) / 1024; };
+		if (mIdeal.memoryCountingEnabled() || memory.limit() != 0)
+		{
+			for (bool peak : { false, true })
+			{
+				output << (peak ? "Peak memory: " : "Memory in use: ") << kib(peak ? memory.peak() : memory.current()) << " KiB (";
+				for (int c = 0; c < MemoryAccount::Categories; ++c)
+				{
+					auto category = static_cast<MemoryAccount::Category>(c);
+					output << (c == 0 ? "" : ", ") << MemoryAccount::name(category) << ' '
+						<< kib(peak ? memory.peak(category) : memory.current(category));
+				}
+				output << ")\n";
+			}
+		}
+		else
+			output << "(memory not counted; \"memory on\" counts it)\n";
+		if (!mIdeal.statisticsEnabled())
+			output << "(not collecting; \"stats on\" resumes)\n";
+	}
+}
+
+void Console::showHilbertSeries(std::istream& input, std::ostream& output)
+{
+	int count = 10;
+	std::string value;
+	if (input >> value)
+	{
+		try
 		{
-			mIdeal.setTermOrder(std::make_unique<LexTermOrder>());
-			output << "Term order changed to lex\n";
+			count = std::stoi(value);
 		}
-		else if (name == "deglex")
+		catch (std::exception&)
 		{
-			mIdeal.setTermOrder(std::make_unique<DegLexTermOrder>());
-			output << "Term order changed to deglex\n";
+			count = -1;
 		}
-		else if (name == "degrevlex")
+		if (count < 1)
 		{
-			mIdeal.setTermOrder(std::make_unique<DegRevLexTermOrder>());
-			output << "Term order changed to degrevlex\n";
+			fail(output) << "Error: expected a number of degrees\n";
+			return;
 		}
+	}
+
+	HilbertSeries series = mIdeal.hilbertSeries(mVarNames.size());
+	output << "H(t) = " << series.toString() << "\n" << "Hilbert function: ";
+	std::vector<long long> values = series.expand(count);
+	for (size_t d = 0; d < values.size(); ++d)
+		output << (d == 0 ? "" : ", ") << values[d];
+	output << "\nDimension " << series.dimension() << ", degree " << series.degree() << "\n";
+	if (!mIdeal.isHomogeneous())
+		output << "(of the leading terms; the ideal is not homogeneous)\n";
+}
+
+void Console::setMemoryCounting(std::istream& input, std::ostream& output)
+{
+	std::string option;
+	input >> option;
+	if (option != "on" && option != "off")
+	{
+		fail(output) << "Error: expected on or off\n";
+		return;
+	}
+	mIdeal.setMemoryCountingEnabled(option == "on");
+	output << "Memory counting " << option << "\n";
+}
+
+void Console::setMemoryLimit(std::istream& input, std::ostream& output)
+{
+	std::string value;
+	input >> value;
+	size_t megabytes = 0;
+	try
+	{
+		if (value != "off")
+			megabytes = std::stoul(value);
+	}
+	catch (std::exception&)
+	{
+		fail(output) << "Error: expected a number of megabytes or off\n";
+		return;
+	}
+	mIdeal.setMemoryLimit(megabytes << 20);
+	if (megabytes == 0)
+		output << "No memory limit\n";
+	else
+		output << "Memory limit " << megabytes << " MB\n";
+}
+
+void Console::setTrace(std::istream& input, std::ostream& output)
+{
+	std::string option, file;
+	input >> option;
+	std::getline(input >> std::ws, file); //the rest of the line, which may contain spaces
+	if (option == "off" && file.empty())
+	{
+		if (mIdeal.tracer())
+			output << "Trace written to " << mIdeal.tracer()->path().string() << "\n";
+		mIdeal.setTracer(nullptr); //finishes the file
+		output << "Not tracing\n";
+	}
+	else if (option == "on" && !file.empty())
+	{
+		try
+		{
+			mIdeal.setTracer(nullptr); //finish any earlier trace first, in case it is the same file
+			mIdeal.setTracer(std::make_shared<Tracer>(file));
+			output << "Tracing to " << file << "\n";
+		}
+		catch (std::exception& ex)
+		{
+			fail(output) << "Error: " << ex.what() << "\n";
+		}
+	}
+	else
+		fail(output) << "Error: expected on FILE or off\n";
+}
+
+void Console::saveBasis(std::istream& input, std::ostream& output)
+{
+	std::string fileName;
+	std::getline(input >> std::ws, fileName);
+	try
+	{
+		std::ofstream file(fileName, std::ios::binary);
+		if (!file)
+			throw std::runtime_error("cannot open " + fileName);
+		mIdeal.write(file, mVarNames);
+		if (!file.flush())
+			throw std::runtime_error("cannot write " + fileName);
+		output << "Saved to " << fileName << "\n";
+	}
+	catch (std::exception& ex)
+	{
+		fail(output) << "Error: " << ex.what() << "\n";
+	}
+}
+
+void Console::openBasis(std::istream& input, std::ostream& output)
+{
+	std::string fileName;
+	std::getline(input >> std::ws, fileName);
+	try
+	{
+		MappedFile file(fileName);
+		BinaryReader<Rational<>> reader(file.data(), file.size());
+		if (reader.header().variables != mVarNames)
+			throw std::runtime_error("the file uses different variables");
+		mIdeal.read(reader);
+		mTermOrderName = matrixName(mIdeal.termOrder().matrix(mVarNames.size()));
+		output << "I := ";
+		mIdeal.print(output, mPrinter);
+		output << "\n";
+	}
+	catch (std::exception& ex)
+	{
+		fail(output) << "Error: " << ex.what() << "\n";
+	}
+}
+
+template <typename Compute>
+void Console::startJob(const std::string& command, const std::string& termOrderName, Compute compute, std::ostream& output)
+{
+	auto job = std::make_unique<Job>();
+	job->command = command;
+	job->ideal = mIdeal;
+	job->termOrderName = termOrderName;
+	job->ideal.setBudget(job->budget);
+	job->ideal.setProgress(job->progress);
+	job->done = std::async(std::launch::async, [ideal = &job->ideal, compute = std::move(compute)]() mutable
+		{ compute(*ideal); });
+	mJob = std::move(job);
+
+	if (!mInteractive)
+	{
+		finishJob(output);
+		return;
+	}
+	finishJob(output, patience);
+	if (mJob)
+		output << "Computing in the background; \"status\" shows the progress, \"cancel\" stops it\n";
+}
+
+void Console::finishJob(std::ostream& output, std::chrono::steady_clock::duration wait)
+{
+	if (!mJob || mJob->done.wait_for(wait) != std::future_status::ready)
+		return;
+	std::unique_ptr<Job> job = std::move(mJob);
+	try
+	{
+		job->done.get();
+		job->ideal.setBudget(nullptr);
+		job->ideal.setProgress(nullptr);
+		mIdeal = std::move(job->ideal); //the previous ideal is only replaced once the new one is ready
+		mTermOrderName = job->termOrderName;
+		if (job->command == "termorder")
+			output << "Term order changed to " << mTermOrderName << "\n";
 		else
 		{
-			output << "Unknown term order " << name << "\n";
+			output << "I := ";
+			mIdeal.print(output, mPrinter);
+			output << "\n";
 		}
 	}
 	catch (std::exception& ex)
 	{
-		output << "Error: " << ex.what() << "\n";
+		fail(output) << "Error: " << ex.what() << "\n";
 	}
 }
+
+void Console::finishJob(std::ostream& output)
+{
+	if (mJob)
+		mJob->done.wait();
+	finishJob(output, std::chrono::steady_clock::duration::zero());
+}
+
+void Console::showStatus(std::istream&, std::ostream& output)
+{
+	if (!mJob)
+	{
+		output << "Nothing is being computed\n";
+		return;
+	}
+	const Progress& progress = *mJob->progress;
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mJob->start;
+	output << "Computing (" << mJob->command << ", " << Progress::name(progress.phase()) << ") for "
+		<< elapsed.count() << " seconds: " << progress.pairsLeft() << " critical pairs left, "
+		<< progress.pairsReduced() << " reduced, basis of " << progress.basisSize() << " elements\n";
+}
+
+void Console::cancelJob(std::istream&, std::ostream& output)
+{
+	if (!mJob)
+	{
+		output << "Nothing is being computed\n";
+		return;
+	}
+	mJob->budget->cancel();
+	finishJob(output); //reports the cancellation, unless it had just finished
+}
+
+void Console::waitForJob(std::istream&, std::ostream& output)
+{
+	if (!mJob)
+		output << "Nothing is being computed\n";
+	finishJob(output);
+}
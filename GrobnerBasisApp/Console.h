@@ -5,9 +5,16 @@ Notes: This class isn't part of the "library", so to speak; it's really just
 the driver for a simplistic command line. A lot of things are hard-coded
 that I'd rather inject at runtime (term order, printer, etc.), but I'm keeping
 it simple for now.
+
+Bases are computed in the background, on a copy of the ideal that replaces it when done,
+so member and reduce keep answering for the previous ideal in the meantime. A computation
+that finishes quickly is reported at once, as if it had not been in the background.
 */
 
 #pragma once
+#include <chrono>
+#include <future>
+#include <memory>
 #include <sstream>
 #include <vector>
 #include "Ideal.h"
@@ -22,12 +29,23 @@ public:
 	// the range [first,last).
 	template<typename StringIterator>
 	Console(StringIterator first, StringIterator last)
-		: mPrinter{ first, last }, mParser{ first, last } {}
+		: mPrinter{ first, last }, mParser{ first, last }, mVarNames{ first, last }
+	{
+		mIdeal.setThreadCount(0); //use every hardware thread by default
+		mIdeal.setStatisticsEnabled(true);
+	}
 
 	// Constructs a Console using the variable names in
 	// the initializer list.
 	Console(std::initializer_list<std::string> varNames)
-		: mPrinter{ varNames }, mParser{ varNames } {}
+		: mPrinter{ varNames }, mParser{ varNames }, mVarNames{ varNames }
+	{
+		mIdeal.setThreadCount(0); //use every hardware thread by default
+		mIdeal.setStatisticsEnabled(true);
+	}
+
+	// Stops any computation in the background.
+	~Console();
 
 	// Returns false after the quit commmand has been issued.
 	operator bool() { return !mQuit; }
@@ -38,15 +56,80 @@ public:
 	// Processes a command and returns a response. 
 	std::string dispatchCommand(const std::string& commandLine);
 
+	// Returns true if the last command failed, having responded with an error.
+	bool failed() const { return mFailed; }
+
+	// Interactive by default. Otherwise, responses are not followed by the >> prompt, and
+	// each command waits for its computation instead of leaving it in the background, as
+	// scripts need.
+	void setInteractive(bool interactive) { mInteractive = interactive; }
+
+	// Returns the term order with the given name, as the termorder command takes it, or
+	// null if there is none.
+	static std::unique_ptr<PowerProduct::TermOrder> makeTermOrder(const std::string& name);
+
 private:
 	StreamPrinter<Rational<>> mPrinter; //to print polynomials, etc.
 	RationalParser mParser; //to parse polynomials
+	std::vector<std::string> mVarNames; //the names of the variables, in order
 	Ideal<Rational<>> mIdeal; //the current ideal being considered
+	std::string mTermOrderName{ "lex" }; //the name of the current term order
 	bool mQuit{ false }; //true if the quit command has been issued
+	bool mFailed{ false }; //true if the last command failed
+	bool mInteractive{ true }; //false to wait for computations and leave out the prompt
+
+	//a basis computation running in the background
+	struct Job
+	{
+		std::string command; //the command that started it
+		Ideal<Rational<>> ideal; //the copy of mIdeal being computed
+		std::string termOrderName; //the name of its term order
+		std::shared_ptr<Budget> budget{ std::make_shared<Budget>() }; //to cancel it
+		std::shared_ptr<Progress> progress{ std::make_shared<Progress>() }; //to follow it
+		std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+		std::future<void> done; //ready when it ends, with any exception it threw
+	};
+	std::unique_ptr<Job> mJob; //the computation in the background, if any; destroyed first, so it ends before mIdeal goes
+
+	//how long a command waits for its computation before leaving it in the background
+	static constexpr std::chrono::milliseconds patience{ 250 };
 
 	void setIdeal(std::istream& input, std::ostream& output); //sets the current ideal
+	void extendIdeal(std::istream& input, std::ostream& output); //adds generators to the current ideal
 	void isMember(std::istream& input, std::ostream& output); //decideds membership
+	void isMemberOf(std::istream& input, std::ostream& output); //decides membership without setting the ideal
 	void reduce(std::istream& input, std::ostream& output); //reduces a polynomial
 	void setTermOrder(std::istream& input, std::ostream& output); //sets term order
+	void setThreadCount(std::istream& input, std::ostream& output); //sets thread count
+	void setCache(std::istream& input, std::ostream& output); //sets the directory to cache bases in
+	void saveBasis(std::istream& input, std::ostream& output); //writes the basis to a file
+	void openBasis(std::istream& input, std::ostream& output); //reads a basis from a file
+	void showStatistics(std::istream& input, std::ostream& output); //prints or controls statistics
+	void setTrace(std::istream& input, std::ostream& output); //starts or stops tracing to a file
+	void setMemoryCounting(std::istream& input, std::ostream& output); //starts or stops counting memory
+	void setMemoryLimit(std::istream& input, std::ostream& output); //sets the soft memory limit
+	void showHilbertSeries(std::istream& input, std::ostream& output); //prints the Hilbert series and function
+	void showStatus(std::istream& input, std::ostream& output); //prints the progress of the computation
+	void cancelJob(std::istream& input, std::ostream& output); //stops the computation
+	void waitForJob(std::istream& input, std::ostream& output); //waits for the computation to end
+
+	//calls compute(ideal) on a copy of mIdeal in the background, to replace mIdeal with the
+	//term order termOrderName; command names the command for the report of its end
+	template <typename Compute>
+	void startJob(const std::string& command, const std::string& termOrderName, Compute compute, std::ostream& output);
+
+	//reports the end of the computation in the background if it ends within wait, or
+	//whenever it ends if wait is not given
+	void finishJob(std::ostream& output, std::chrono::steady_clock::duration wait);
+	void finishJob(std::ostream& output);
+
+	//returns the name makeTermOrder takes for the order described by matrix
+	static std::string matrixName(const PowerProduct::TermOrder::Matrix& matrix);
+
+	//marks the command as failed and returns output, to write the error to
+	std::ostream& fail(std::ostream& output);
+
+	//parses the comma-separated polynomials on the rest of the line
+	std::vector<Polynomial<Rational<int>>> parseList(std::istream& input, bool allowEmpty) const;
 };
 
@@ -0,0 +1,330 @@
+#include "Json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+//a recursive descent parser over the text
+class Json::Parser
+{
+public:
+	explicit Parser(const std::string& text) : mText{ text } {}
+
+	Json parseAll()
+	{
+		Json value = parseValue();
+		skipSpace();
+		if (mPos != mText.size())
+			fail("unexpected text after the value");
+		return value;
+	}
+
+private:
+	//the deepest nesting of arrays and objects parsed, so untrusted text cannot exhaust the stack
+	static constexpr size_t maxDepth = 1000;
+
+	const std::string& mText;
+	size_t mPos{ 0 };
+	size_t mDepth{ 0 };
+
+	[[noreturn]] void fail(const std::string& message) const
+	{
+		throw ParseException("invalid JSON at character " + std::to_string(mPos + 1) + ": " + message);
+	}
+
+	void skipSpace()
+	{
+		while (mPos < mText.size() && (mText[mPos] == ' ' || mText[mPos] == '\t' || mText[mPos] == '\n' || mText[mPos] == '\r'))
+			++mPos;
+	}
+
+	bool consume(char c)
+	{
+		skipSpace();
+		if (mPos < mText.size() && mText[mPos] == c)
+		{
+			++mPos;
+			return true;
+		}
+		return false;
+	}
+
+	//count an opening bracket, failing if they are nested too deeply to parse recursively
+	void enter()
+	{
+		if (++mDepth > maxDepth)
+			fail("arrays and objects nested too deeply");
+	}
+
+	//count a closing bracket
+	void leave() { --mDepth; }
+
+	void consumeWord(const char* word)
+	{
+		for (; *word; ++word, ++mPos)
+			if (mPos >= mText.size() || mText[mPos] != *word)
+				fail("unknown value");
+	}
+
+	Json parseValue()
+	{
+		skipSpace();
+		if (mPos >= mText.size())
+			fail("expected a value");
+		Json value;
+		char c = mText[mPos];
+		if (c == '{')
+		{
+			enter();
+			++mPos;
+			value.mType = Object;
+			if (consume('}'))
+			{
+				leave();
+				return value;
+			}
+			do
+			{
+				skipSpace();
+				if (mPos >= mText.size() || mText[mPos] != '"')
+					fail("expected a member name");
+				std::string key = parseString();
+				if (!consume(':'))
+					fail("expected :");
+				value.mObject[key] = parseValue();
+			} while (consume(','));
+			if (!consume('}'))
+				fail("expected , or }");
+			leave();
+		}
+		else if (c == '[')
+		{
+			enter();
+			++mPos;
+			value.mType = Array;
+			if (consume(']'))
+			{
+				leave();
+				return value;
+			}
+			do
+				value.mArray.push_back(parseValue());
+			while (consume(','));
+			if (!consume(']'))
+				fail("expected , or ]");
+			leave();
+		}
+		else if (c == '"')
+		{
+			value.mType = String;
+			value.mString = parseString();
+		}
+		else if (c == 't' || c == 'f')
+		{
+			value.mType = Bool;
+			value.mBool = c == 't';
+			consumeWord(value.mBool ? "true" : "false");
+		}
+		else if (c == 'n')
+			consumeWord("null");
+		else if (c == '-' || (c >= '0' && c <= '9'))
+		{
+			const char* start = mText.c_str() + mPos;
+			char* end;
+			value.mType = Number;
+			value.mNumber = std::strtod(start, &end);
+			mPos += end - start;
+		}
+		else
+			fail("expected a value");
+		return value;
+	}
+
+	//the string starting at the opening quote
+	std::string parseString()
+	{
+		std::string s;
+		++mPos;
+		while (true)
+		{
+			if (mPos >= mText.size())
+				fail("unterminated string");
+			char c = mText[mPos++];
+			if (c == '"')
+				return s;
+			if (c != '\\')
+			{
+				s += c;
+				continue;
+			}
+			if (mPos >= mText.size())
+				fail("unterminated string");
+			switch (char e = mText[mPos++])
+			{
+			case '"': case '\\': case '/': s += e; break;
+			case 'b': s += '\b'; break;
+			case 'f': s += '\f'; break;
+			case 'n': s += '\n'; break;
+			case 'r': s += '\r'; break;
+			case 't': s += '\t'; break;
+			case 'u': appendUtf8(s, parseCodePoint()); break;
+			default: fail("unknown escape");
+			}
+		}
+	}
+
+	//the code point of a \u escape whose u has been read, joining surrogate pairs
+	unsigned long parseCodePoint()
+	{
+		unsigned long code = parseHex();
+		if (code >= 0xD800 && code < 0xDC00 && mText.compare(mPos, 2, "\\u") == 0)
+		{
+			mPos += 2;
+			unsigned long low = parseHex();
+			if (low < 0xDC00 || low >= 0xE000)
+				fail("invalid surrogate pair");
+			code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+		}
+		return code;
+	}
+
+	unsigned long parseHex()
+	{
+		if (mPos + 4 > mText.size())
+			fail("expected four hex digits");
+		std::string digits = mText.substr(mPos, 4);
+		char* end;
+		unsigned long code = std::strtoul(digits.c_str(), &end, 16);
+		if (end != digits.c_str() + 4)
+			fail("expected four hex digits");
+		mPos += 4;
+		return code;
+	}
+
+	static void appendUtf8(std::string& s, unsigned long code)
+	{
+		if (code < 0x80)
+			s += static_cast<char>(code);
+		else if (code < 0x800)
+		{
+			s += static_cast<char>(0xC0 | (code >> 6));
+			s += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000)
+		{
+			s += static_cast<char>(0xE0 | (code >> 12));
+			s += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			s += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			s += static_cast<char>(0xF0 | (code >> 18));
+			s += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			s += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			s += static_cast<char>(0x80 | (code & 0x3F));
+		}
+	}
+};
+
+Json Json::parse(const std::string& text)
+{
+	return Parser(text).parseAll();
+}
+
+std::string Json::quote(const std::string& text)
+{
+	std::string quoted = "\"";
+	for (char c : text)
+	{
+		switch (c)
+		{
+		case '"': quoted += "\\\""; break;
+		case '\\': quoted += "\\\\"; break;
+		case '\n': quoted += "\\n"; break;
+		case '\r': quoted += "\\r"; break;
+		case '\t': quoted += "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				char escape[8];
+				std::snprintf(escape, sizeof escape, "\\u%04x", c);
+				quoted += escape;
+			}
+			else
+				quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+
+std::string Json::write() const
+{
+	switch (mType)
+	{
+	case Bool:
+		return mBool ? "true" : "false";
+	case Number:
+	{
+		if (!std::isfinite(mNumber))
+			return "null";
+		char buffer[32];
+		std::snprintf(buffer, sizeof buffer, "%.17g", mNumber);
+		return buffer;
+	}
+	case String:
+		return quote(mString);
+	case Array:
+	{
+		std::string s = "[";
+		for (size_t i = 0; i < mArray.size(); ++i)
+			s += (i == 0 ? "" : ",") + mArray[i].write();
+		return s + "]";
+	}
+	case Object:
+	{
+		std::string s = "{";
+		for (const auto& member : mObject)
+			s += (s.size() == 1 ? "" : ",") + quote(member.first) + ":" + member.second.write();
+		return s + "}";
+	}
+	default:
+		return "null";
+	}
+}
+
+bool Json::boolean() const
+{
+	expect(Bool, "true or false");
+	return mBool;
+}
+
+double Json::number() const
+{
+	expect(Number, "a number");
+	return mNumber;
+}
+
+const std::string& Json::string() const
+{
+	expect(String, "a string");
+	return mString;
+}
+
+const std::vector<Json>& Json::array() const
+{
+	expect(Array, "an array");
+	return mArray;
+}
+
+const Json& Json::operator[](const std::string& key) const
+{
+	static const Json null;
+	expect(Object, "an object");
+	auto found = mObject.find(key);
+	return found == mObject.end() ? null : found->second;
+}
+
+void Json::expect(Type type, const char* name) const
+{
+	if (mType != type)
+		throw ParseException(std::string("expected ") + name);
+}
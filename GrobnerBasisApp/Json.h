@@ -0,0 +1,65 @@
+/*
+Notes: Just enough JSON for the server's requests: a parsed value can be inspected, and
+anything can be written back out. Responses are written directly as text, using quote for
+strings and write for values taken from requests, such as their ids.
+*/
+
+#pragma once
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A JSON value.
+class Json final
+{
+public:
+	enum Type { Null, Bool, Number, String, Array, Object };
+
+	// Thrown by parse for text that is not JSON, and by the accessors for values of the
+	// wrong type.
+	class ParseException : public std::runtime_error
+	{
+	public:
+		explicit ParseException(const std::string& message) : std::runtime_error(message) {}
+	};
+
+	// Constructs null.
+	Json() = default;
+
+	// Parses text, which must hold exactly one value.
+	static Json parse(const std::string& text);
+
+	// Returns text as a JSON string: quoted, with quotes, backslashes and control
+	// characters escaped.
+	static std::string quote(const std::string& text);
+
+	// Returns this value as JSON text, on one line.
+	std::string write() const;
+
+	Type type() const { return mType; }
+	bool isNull() const { return mType == Null; }
+
+	// Return the value, throwing ParseException if it has another type.
+	bool boolean() const;
+	double number() const;
+	const std::string& string() const;
+	const std::vector<Json>& array() const;
+
+	// Returns the member of an object named key, or null if there is none. Throws
+	// ParseException if this is not an object.
+	const Json& operator[](const std::string& key) const;
+
+private:
+	Type mType{ Null };
+	bool mBool{ false };
+	double mNumber{ 0 };
+	std::string mString;
+	std::vector<Json> mArray;
+	std::map<std::string, Json> mObject;
+
+	class Parser;
+
+	//throw if this is not of type, which name describes
+	void expect(Type type, const char* name) const;
+};
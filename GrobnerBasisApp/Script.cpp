@@ -0,0 +1,49 @@
+#include "Script.h"
+#include "Json.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+size_t runScript(Console& console, std::istream& script, std::ostream& out)
+{
+	using Clock = std::chrono::steady_clock;
+	auto seconds = [](Clock::duration elapsed)
+	{
+		char text[32];
+		std::snprintf(text, sizeof text, "%.6f", std::chrono::duration<double>(elapsed).count());
+		return std::string(text);
+	};
+
+	console.setInteractive(false);
+	size_t lineNumber = 0, commands = 0, failures = 0;
+	Clock::duration total{};
+	for (std::string line; console && std::getline(script, line);)
+	{
+		++lineNumber;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		size_t first = line.find_first_not_of(" \t");
+		if (first == std::string::npos || line[first] == '#') //blank lines and comments
+			continue;
+
+		auto start = Clock::now();
+		std::string response = console.dispatchCommand(line);
+		auto elapsed = Clock::now() - start;
+		total += elapsed;
+		++commands;
+		if (console.failed())
+			++failures;
+
+		out << "{\"line\":" << lineNumber << ",\"command\":" << Json::quote(line.substr(first))
+			<< ",\"ok\":" << (console.failed() ? "false" : "true") << ",\"seconds\":" << seconds(elapsed)
+			<< ",\"output\":[";
+		std::istringstream responseLines(response);
+		bool firstLine = true;
+		for (std::string responseLine; std::getline(responseLines, responseLine); firstLine = false)
+			out << (firstLine ? "" : ",") << Json::quote(responseLine);
+		out << "]}" << std::endl;
+	}
+	out << "{\"commands\":" << commands << ",\"failed\":" << failures << ",\"seconds\":" << seconds(total) << "}" << std::endl;
+	return failures;
+}
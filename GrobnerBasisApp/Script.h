@@ -0,0 +1,17 @@
+/*
+Notes: A script is a file of console commands, one per line, run without a prompt for
+repeatable measurements. Each command is reported as a line of JSON, so runs can be compared
+by a program: its line number and text, whether it succeeded, the seconds it took, and the
+console's response, line by line. Computations are waited for, so a command's time includes
+the whole of its basis computation.
+*/
+
+#pragma once
+#include "Console.h"
+#include <iosfwd>
+
+// Runs the commands read from script, one per line, on console, which is made non-interactive,
+// and writes a line of JSON to out for each, then a summary line with the number of commands,
+// the number that failed, and the total seconds. Blank lines and lines starting with # are
+// skipped; quit ends the script. Returns the number of commands that failed.
+size_t runScript(Console& console, std::istream& script, std::ostream& out);
@@ -0,0 +1,327 @@
+#include "Server.h"
+#include "Console.h"
+#include "StreamPrinter.h"
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+std::string Server::handle(const std::string& line)
+{
+	auto start = Clock::now();
+	std::string id = "null";
+	std::string response;
+	bool ok = true;
+	try
+	{
+		Json request = Json::parse(line);
+		id = request["id"].write(); //echoed, so clients can match responses to requests
+		dispatch(request, response);
+	}
+	catch (std::exception& ex)
+	{
+		ok = false;
+		response = ",\"error\":" + Json::quote(ex.what());
+	}
+
+	char seconds[32];
+	std::snprintf(seconds, sizeof seconds, "%.6f", std::chrono::duration<double>(Clock::now() - start).count());
+	return "{\"id\":" + id + ",\"ok\":" + (ok ? "true" : "false") + response + ",\"seconds\":" + seconds + "}";
+}
+
+void Server::dispatch(const Json& request, std::string& response)
+{
+	const std::string& op = request["op"].string();
+	if (op == "define")
+	{
+		const std::string& name = request["name"].string();
+		auto gens = parsePolynomials(request, "generators");
+		std::string orderName = request["order"].isNull() ? "lex" : request["order"].string();
+		auto termOrder = Console::makeTermOrder(orderName);
+		if (!termOrder)
+			throw std::runtime_error("unknown term order " + orderName);
+		Ideal<Q> ideal;
+		ideal.setBudget(makeBudget(request));
+		ideal.setTermOrder(std::move(termOrder));
+		ideal.setGenerators(gens.begin(), gens.end());
+		storeIdeal(name, std::move(ideal), response);
+	}
+	else if (op == "extend")
+	{
+		auto gens = parsePolynomials(request, "generators");
+		Ideal<Q> ideal = *findIdeal(request); //a copy; the stored ideal stays as it is
+		ideal.setBudget(makeBudget(request));
+		ideal.addGenerators(gens.begin(), gens.end());
+		storeIdeal(request["name"].string(), std::move(ideal), response);
+	}
+	else if (op == "termorder")
+	{
+		const std::string& orderName = request["order"].string();
+		auto termOrder = Console::makeTermOrder(orderName);
+		if (!termOrder)
+			throw std::runtime_error("unknown term order " + orderName);
+		Ideal<Q> ideal = *findIdeal(request);
+		ideal.setBudget(makeBudget(request));
+		ideal.setTermOrder(std::move(termOrder));
+		storeIdeal(request["name"].string(), std::move(ideal), response);
+	}
+	else if (op == "member")
+	{
+		auto ideal = findIdeal(request);
+		auto polys = parsePolynomials(request, "polynomials");
+		std::vector<char> answers;
+		ideal->isMemberAll(polys.begin(), polys.end(), std::back_inserter(answers));
+		response += ",\"members\":[";
+		for (size_t i = 0; i < answers.size(); ++i)
+			response += std::string(i == 0 ? "" : ",") + (answers[i] ? "true" : "false");
+		response += "]";
+	}
+	else if (op == "reduce")
+	{
+		auto ideal = findIdeal(request);
+		auto polys = parsePolynomials(request, "polynomials");
+		std::vector<Polynomial<Q>> remainders;
+		ideal->reduceAll(polys.begin(), polys.end(), std::back_inserter(remainders));
+		response += ",\"remainders\":[";
+		for (size_t i = 0; i < remainders.size(); ++i)
+			response += (i == 0 ? "" : ",") + polynomialString(remainders[i], ideal->termOrder());
+		response += "]";
+	}
+	else if (op == "basis")
+		response += ",\"basis\":" + basisArray(*findIdeal(request));
+	else if (op == "drop")
+		response += std::string(",\"dropped\":") + (mRegistry.erase(request["name"].string()) ? "true" : "false");
+	else if (op == "list")
+	{
+		response += ",\"ideals\":[";
+		auto entries = mRegistry.entries();
+		size_t bytes = 0;
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			const auto& entry = entries[i];
+			response += std::string(i == 0 ? "" : ",") + "{\"name\":" + Json::quote(entry.name)
+				+ ",\"elements\":" + std::to_string(entry.ideal->end() - entry.ideal->begin())
+				+ ",\"bytes\":" + std::to_string(entry.bytes) + "}";
+			bytes += entry.bytes;
+		}
+		response += "],\"bytes\":" + std::to_string(bytes);
+	}
+	else if (op == "shutdown")
+		mStopping = true; //the server stops once the response is sent
+	else
+		throw std::runtime_error("unknown op " + op);
+}
+
+IdealRegistry<Server::Q>::IdealPtr Server::findIdeal(const Json& request)
+{
+	const std::string& name = request["name"].string();
+	auto ideal = mRegistry.find(name);
+	if (!ideal)
+		throw std::runtime_error("no ideal named " + name);
+	return ideal;
+}
+
+std::vector<Polynomial<Rational<int>>> Server::parsePolynomials(const Json& request, const char* key) const
+{
+	std::vector<Polynomial<Rational<int>>> polys;
+	for (const Json& poly : request[key].array())
+		polys.push_back(mParser.parse(poly.string()));
+	return polys;
+}
+
+std::shared_ptr<Budget> Server::makeBudget(const Json& request)
+{
+	const Json& timeout = request["timeoutMs"];
+	if (timeout.isNull())
+		return nullptr;
+	auto budget = std::make_shared<Budget>();
+	budget->setTimeLimit(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(timeout.number())));
+	return budget;
+}
+
+void Server::storeIdeal(const std::string& name, Ideal<Q> ideal, std::string& response)
+{
+	ideal.setBudget(nullptr); //its questions are not limited
+	response += ",\"name\":" + Json::quote(name) + ",\"basis\":" + basisArray(ideal);
+	std::vector<std::string> evicted = mRegistry.store(name, std::move(ideal));
+	if (!evicted.empty())
+	{
+		response += ",\"evicted\":[";
+		for (size_t i = 0; i < evicted.size(); ++i)
+			response += (i == 0 ? "" : ",") + Json::quote(evicted[i]);
+		response += "]";
+	}
+}
+
+std::string Server::polynomialString(const Polynomial<Q>& p, const PowerProduct::TermOrder& termOrder) const
+{
+	StreamPrinter<Q> printer(mVarNames.begin(), mVarNames.end()); //printers are not shared between threads
+	std::ostringstream ss;
+	p.print(ss, printer, termOrder);
+	return Json::quote(ss.str());
+}
+
+std::string Server::basisArray(const Ideal<Q>& ideal) const
+{
+	std::string basis = "[";
+	for (auto it = ideal.begin(); it != ideal.end(); ++it)
+		basis += (it == ideal.begin() ? "" : ",") + polynomialString(*it, ideal.termOrder());
+	return basis + "]";
+}
+
+void Server::serve(std::istream& in, std::ostream& out)
+{
+	for (std::string line; !mStopping && std::getline(in, line);)
+		if (line.find_first_not_of(" \t\r") != std::string::npos) //blank lines are ignored
+			out << handle(line) << std::endl;
+}
+
+#ifdef _WIN32
+
+void Server::listen(const std::string& path)
+{
+	throw std::system_error(std::make_error_code(std::errc::operation_not_supported),
+		"Unix domain sockets are not supported on this platform; use --server");
+}
+
+void Server::serveConnection(int connection) {}
+
+void Server::stop() {}
+
+#else
+
+namespace
+{
+	//write all of data to connection; false if it fails, as when the client has hung up
+	bool sendAll(int connection, const std::string& data)
+	{
+		for (size_t sent = 0; sent < data.size();)
+		{
+			ssize_t n = send(connection, data.data() + sent, data.size() - sent, 0);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			sent += n;
+		}
+		return true;
+	}
+}
+
+void Server::listen(const std::string& path)
+{
+	std::signal(SIGPIPE, SIG_IGN); //a client that hangs up is seen as a failed write instead
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof address.sun_path)
+		throw std::system_error(std::make_error_code(std::errc::filename_too_long), path);
+	path.copy(address.sun_path, path.size());
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0)
+		throw std::system_error(errno, std::generic_category(), "cannot make a socket");
+	if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0
+		|| ::listen(listener, SOMAXCONN) != 0)
+	{
+		int error = errno;
+		close(listener);
+		throw std::system_error(error, std::generic_category(), "cannot listen on " + path);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mSocketMutex);
+		mListener = listener;
+	}
+
+	//until stop shuts the listener down
+	while (!mStopping)
+	{
+		int connection = accept(listener, nullptr, nullptr);
+		if (connection < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			break;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mSocketMutex);
+			if (mStopping)
+			{
+				close(connection);
+				break;
+			}
+			//each connection keeps a worker until it closes, so one more would wait for it
+			if (mConnections.size() >= mWorkers.size())
+			{
+				sendAll(connection, "{\"id\":null,\"ok\":false,\"error\":\"too many connections; at most "
+					+ std::to_string(mWorkers.size()) + " are served at once\"}\n");
+				close(connection);
+				continue;
+			}
+			mConnections.insert(connection);
+		}
+		mWorkers.submit([this, connection]() { serveConnection(connection); });
+	}
+
+	stop();
+	{
+		std::lock_guard<std::mutex> lock(mSocketMutex);
+		mListener = -1;
+	}
+	close(listener);
+	unlink(path.c_str());
+}
+
+void Server::serveConnection(int connection)
+{
+	//read whole lines into buffer and answer each
+	std::string buffer;
+	char chunk[4096];
+	bool open = true;
+	while (open)
+	{
+		ssize_t received = recv(connection, chunk, sizeof chunk, 0);
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received <= 0)
+			break;
+		buffer.append(chunk, received);
+		size_t start = 0;
+		for (size_t end; open && (end = buffer.find('\n', start)) != std::string::npos; start = end + 1)
+		{
+			std::string line = buffer.substr(start, end - start);
+			if (line.find_first_not_of(" \t\r") == std::string::npos)
+				continue;
+			open = sendAll(connection, handle(line) + "\n");
+			if (mStopping) //after a shutdown request, here or on another connection
+			{
+				stop();
+				open = false;
+			}
+		}
+		buffer.erase(0, start);
+	}
+
+	std::lock_guard<std::mutex> lock(mSocketMutex);
+	mConnections.erase(connection);
+	close(connection);
+}
+
+void Server::stop()
+{
+	//shutting the sockets down wakes the threads blocked on them, which then close them
+	std::lock_guard<std::mutex> lock(mSocketMutex);
+	if (mListener >= 0)
+		shutdown(mListener, SHUT_RDWR);
+	for (int connection : mConnections)
+		shutdown(connection, SHUT_RDWR);
+}
+
+#endif
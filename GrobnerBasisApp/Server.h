@@ -0,0 +1,105 @@
+/*
+Notes: The server keeps computed bases between requests, so a client can define an ideal
+once and then ask any number of questions about it, as can other clients. Requests and
+responses are JSON objects, one per line (see the help for --server in main.cpp for the
+operations). Each connection to the socket is served by one of the workers for as long as
+it is open, answering its requests in order; requests on different connections run
+concurrently. So there are only as many connections as workers: one more is answered with
+an error and closed, rather than left waiting for a worker that may never come free.
+Questions are answered from a shared, unchanging ideal, so they never wait for a
+computation; computations work on a copy and store it when done (see IdealRegistry).
+*/
+
+#pragma once
+#include "Ideal.h"
+#include "IdealRegistry.h"
+#include "RationalParser.h"
+#include "ThreadPool.h"
+#include "Json.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Answers requests about named ideals, as lines of JSON, from a stream or a Unix domain socket.
+class Server final
+{
+public:
+	// Limits on the server: the most ideals and the most bytes (by estimate) of them to keep,
+	// 0 for no limit, and the most connections open at once, each served by a worker thread,
+	// 0 for one per hardware thread.
+	struct Options
+	{
+		size_t maxIdeals{ 64 };
+		size_t maxBytes{ size_t(1) << 30 };
+		unsigned workers{ 0 };
+	};
+
+	// Constructs a server for polynomials in the variables named in the range [first,last).
+	template <typename StringIterator>
+	Server(StringIterator first, StringIterator last, const Options& options)
+		: mVarNames(first, last), mParser{ first, last },
+		mRegistry{ options.maxIdeals, options.maxBytes },
+		mWorkers{ options.workers != 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency()) } {}
+
+	// Answers a request, a line of JSON, with a line of JSON (without the newline).
+	// May be called concurrently.
+	std::string handle(const std::string& request);
+
+	// Answers the requests read from in, one per line, writing each response to out, until
+	// in ends or a shutdown request.
+	void serve(std::istream& in, std::ostream& out);
+
+	// Listens on the Unix domain socket at path, which must not exist, answering requests
+	// on each connection as serve does, until a shutdown request on any of them. A connection
+	// beyond Options::workers gets an error response and is closed. Throws
+	// std::system_error if the socket cannot be made.
+	void listen(const std::string& path);
+
+	// Returns true once a shutdown request has been answered.
+	bool stopping() const { return mStopping; }
+
+private:
+	using Q = Rational<>;
+	using Clock = std::chrono::steady_clock;
+
+	std::vector<std::string> mVarNames; //the names of the variables, in order
+	RationalParser mParser; //to parse polynomials; used concurrently
+	IdealRegistry<Q> mRegistry; //the ideals by name
+	ThreadPool mWorkers; //serve the connections
+	std::atomic<bool> mStopping{ false }; //set by a shutdown request
+
+	std::mutex mSocketMutex; //guards the sockets below
+	int mListener{ -1 }; //the listening socket, while listening
+	std::set<int> mConnections; //the open connections
+
+	//answer a parsed request, writing the members of the response after "ok" to response
+	void dispatch(const Json& request, std::string& response);
+
+	//the ideal stored under request["name"]; throws if there is none
+	IdealRegistry<Q>::IdealPtr findIdeal(const Json& request);
+
+	//parse request[key], an array of polynomials
+	std::vector<Polynomial<Rational<int>>> parsePolynomials(const Json& request, const char* key) const;
+
+	//a budget with the deadline in request["timeoutMs"], or null if it has none
+	static std::shared_ptr<Budget> makeBudget(const Json& request);
+
+	//store ideal under name and write its basis and any evictions to response
+	void storeIdeal(const std::string& name, Ideal<Q> ideal, std::string& response);
+
+	//p, written in termOrder, or the basis of ideal, as JSON strings
+	std::string polynomialString(const Polynomial<Q>& p, const PowerProduct::TermOrder& termOrder) const;
+	std::string basisArray(const Ideal<Q>& ideal) const;
+
+	//answer the requests on an accepted connection until it closes
+	void serveConnection(int connection);
+
+	//stop listening and close the connections, so their workers finish
+	void stop();
+};
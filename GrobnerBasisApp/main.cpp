@@ -2,18 +2,133 @@
 Author: Elias Sink
 Date: 5/12/2022
 */
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include "Console.h"
+#include "Script.h"
+#include "Server.h"
 
-int main()
+//printed for --help and bad arguments
+const char* usage =
+"Usage: GrobnerBasisApp [options]\n"
+"With no options, runs the interactive console.\n\n"
+"  --script FILE         run the console commands in FILE (- for standard input), one per line,\n"
+"                        and write a line of JSON for each: its line, command, ok, seconds and\n"
+"                        output lines; then the commands, failed and seconds in all. Exits with\n"
+"                        1 if any command failed\n"
+"  --server              answer JSON requests, one per line, on standard input and output\n"
+"  --socket PATH         answer JSON requests on each connection to a Unix domain socket at PATH\n"
+"  --workers N           connections to the socket open at once, each with its own thread; more\n"
+"                        are refused with an error (default one per hardware thread)\n"
+"  --max-ideals N        ideals kept; the least recently used are dropped (default 64, 0 for no limit)\n"
+"  --max-memory MB       estimated memory for the ideals kept (default 1024, 0 for no limit)\n"
+"  --variables NAMES     the variables, separated by commas (default z,y,x)\n\n"
+"Each request is an object with an \"op\" and optionally an \"id\", which the response echoes\n"
+"along with \"ok\", the answer or an \"error\", and the \"seconds\" taken:\n"
+"  {\"op\":\"define\",\"name\":N,\"generators\":[P,...],\"order\":O,\"timeoutMs\":T} -> \"basis\"\n"
+"  {\"op\":\"extend\",\"name\":N,\"generators\":[P,...],\"timeoutMs\":T} -> \"basis\"\n"
+"  {\"op\":\"termorder\",\"name\":N,\"order\":O,\"timeoutMs\":T} -> \"basis\"\n"
+"  {\"op\":\"member\",\"name\":N,\"polynomials\":[P,...]} -> \"members\"\n"
+"  {\"op\":\"reduce\",\"name\":N,\"polynomials\":[P,...]} -> \"remainders\"\n"
+"  {\"op\":\"basis\",\"name\":N} -> \"basis\"\n"
+"  {\"op\":\"drop\",\"name\":N} -> \"dropped\"\n"
+"  {\"op\":\"list\"} -> \"ideals\" (name, elements, bytes), \"bytes\"\n"
+"  {\"op\":\"shutdown\"}\n"
+"Orders are named as for the console's termorder command (default lex); timeoutMs is optional.\n"
+"Storing an ideal may evict others, listed in \"evicted\".\n";
+
+int main(int argc, char* argv[])
 {
-	Console console{ "z","y","x" }; //variable names in reverse order to look better
-	
+	bool server = false;
+	std::string socketPath, scriptPath;
+	std::vector<std::string> variables{ "z","y","x" }; //variable names in reverse order to look better
+	Server::Options options;
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto value = [&]() -> std::string
+			{
+				if (i + 1 >= argc)
+					throw std::invalid_argument(arg + " needs a value");
+				return argv[++i];
+			};
+			if (arg == "--script")
+				scriptPath = value();
+			else if (arg == "--server")
+				server = true;
+			else if (arg == "--socket")
+				socketPath = value();
+			else if (arg == "--workers")
+				options.workers = std::stoul(value());
+			else if (arg == "--max-ideals")
+				options.maxIdeals = std::stoul(value());
+			else if (arg == "--max-memory")
+				options.maxBytes = static_cast<size_t>(std::stoull(value())) << 20;
+			else if (arg == "--variables")
+			{
+				variables.clear();
+				std::istringstream names(value());
+				for (std::string name; std::getline(names, name, ',');)
+					variables.push_back(name);
+			}
+			else if (arg == "--help")
+			{
+				std::cout << usage;
+				return 0;
+			}
+			else
+				throw std::invalid_argument("unknown option " + arg);
+		}
+	}
+	catch (std::exception& ex)
+	{
+		std::cerr << "Error: " << ex.what() << "\n" << usage;
+		return 2;
+	}
+
+	if (server || !socketPath.empty())
+	{
+		try
+		{
+			Server answering(variables.begin(), variables.end(), options);
+			if (socketPath.empty())
+				answering.serve(std::cin, std::cout);
+			else
+				answering.listen(socketPath);
+		}
+		catch (std::exception& ex)
+		{
+			std::cerr << "Error: " << ex.what() << "\n";
+			return 1;
+		}
+		return 0;
+	}
+
+	Console console{ variables.begin(), variables.end() };
+
+	if (!scriptPath.empty())
+	{
+		std::ifstream file;
+		if (scriptPath != "-")
+		{
+			file.open(scriptPath);
+			if (!file)
+			{
+				std::cerr << "Error: cannot open " << scriptPath << "\n";
+				return 1;
+			}
+		}
+		return runScript(console, scriptPath == "-" ? std::cin : file, std::cout) == 0 ? 0 : 1;
+	}
+
 	std::cout << console.header();
 	for (std::string line; console && std::getline(std::cin, line); ) //input loop
 	{
 		std::cout << console.dispatchCommand(line);
 	}
 	return 0;
-}
\ No newline at end of file
+}
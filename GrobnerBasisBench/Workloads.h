@@ -0,0 +1,187 @@
+/*
+Notes: These are the standard benchmark systems from the polynomial system solving
+literature, written out from their definitions. Random systems use std::mt19937 directly,
+rather than a distribution, so a seed gives the same system with every standard library.
+*/
+
+#pragma once
+#include "Polynomial.h"
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Generates the polynomial systems that are benchmarked, by family name and size.
+class Workloads final
+{
+public:
+	// The names of the families: cyclic, katsura, eco, noon, random-dense, random-sparse.
+	static const std::vector<std::string>& families()
+	{
+		static const std::vector<std::string> names{ "cyclic", "katsura", "eco", "noon", "random-dense", "random-sparse" };
+		return names;
+	}
+
+	// The size of each family run by default, small enough that every term order finishes
+	// in seconds with 64-bit rational coefficients, which overflow on larger sizes of some.
+	static int defaultSize(const std::string& family)
+	{
+		if (family == "cyclic" || family == "eco")
+			return 4;
+		if (family == "random-sparse")
+			return 3;
+		return 2; //katsura, noon, random-dense
+	}
+
+	// Returns the generators of the system of the family and size, with coefficients of type
+	// CoefT. seed only affects random systems. Throws std::invalid_argument for an unknown family
+	// or a size less than 2.
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> generate(const std::string& family, int size, unsigned seed = 1)
+	{
+		if (size < 2)
+			throw std::invalid_argument("size must be at least 2");
+		if (family == "cyclic")
+			return cyclic<CoefT>(size);
+		if (family == "katsura")
+			return katsura<CoefT>(size);
+		if (family == "eco")
+			return eco<CoefT>(size);
+		if (family == "noon")
+			return noon<CoefT>(size);
+		if (family == "random-dense")
+			return random<CoefT>(size, 2, 0, seed);
+		if (family == "random-sparse")
+			return random<CoefT>(size, 2, size + 1, seed);
+		throw std::invalid_argument("unknown family " + family);
+	}
+
+private:
+	//the nth variable
+	template <typename CoefT>
+	static Polynomial<CoefT> var(size_t n) { return PowerProduct(n); }
+
+	//cyclic-n: the sums of the products of k cyclically consecutive variables for k < n,
+	//and the product of all of them minus 1
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> cyclic(int n)
+	{
+		std::vector<Polynomial<CoefT>> system;
+		for (int k = 1; k < n; ++k)
+		{
+			Polynomial<CoefT> sum;
+			for (int i = 0; i < n; ++i)
+			{
+				std::vector<int> degrees(n);
+				for (int j = 0; j < k; ++j)
+					degrees[(i + j) % n] += 1;
+				sum += PowerProduct(degrees);
+			}
+			system.push_back(sum);
+		}
+		system.push_back(PowerProduct(std::vector<int>(n, 1)) - Polynomial<CoefT>(1));
+		return system;
+	}
+
+	//katsura-n, in the n + 1 variables u_0,...,u_n, with u_-l = u_l and u_l = 0 for l > n:
+	//sum over l of u_l*u_(m-l) - u_m for m < n, and sum over l of u_l - 1
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> katsura(int n)
+	{
+		auto u = [n](int l) { return std::abs(l) > n ? Polynomial<CoefT>() : var<CoefT>(std::abs(l)); };
+		std::vector<Polynomial<CoefT>> system;
+		for (int m = 0; m < n; ++m)
+		{
+			Polynomial<CoefT> sum = -u(m);
+			for (int l = -n; l <= n; ++l)
+				sum += u(l) * u(m - l);
+			system.push_back(sum);
+		}
+		Polynomial<CoefT> sum = -1;
+		for (int l = -n; l <= n; ++l)
+			sum += u(l);
+		system.push_back(sum);
+		return system;
+	}
+
+	//eco-n, in x_1,...,x_n: (x_k + sum of x_i*x_(i+k) for i < n - k) * x_n - k for k < n,
+	//and x_1 + ... + x_(n-1) + 1
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> eco(int n)
+	{
+		auto x = [](int i) { return var<CoefT>(i - 1); };
+		std::vector<Polynomial<CoefT>> system;
+		for (int k = 1; k < n; ++k)
+		{
+			Polynomial<CoefT> sum = x(k);
+			for (int i = 1; i < n - k; ++i)
+				sum += x(i) * x(i + k);
+			system.push_back(sum * x(n) - k);
+		}
+		Polynomial<CoefT> sum = 1;
+		for (int i = 1; i < n; ++i)
+			sum += x(i);
+		system.push_back(sum);
+		return system;
+	}
+
+	//noon-n: x_i * (sum of x_j^2 for j != i) - 11/10 * x_i + 1, scaled by 10
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> noon(int n)
+	{
+		std::vector<Polynomial<CoefT>> system;
+		for (int i = 0; i < n; ++i)
+		{
+			Polynomial<CoefT> squares;
+			for (int j = 0; j < n; ++j)
+				if (j != i)
+					squares += var<CoefT>(j).pow(2);
+			system.push_back(10 * var<CoefT>(i) * squares - 11 * var<CoefT>(i) + 10);
+		}
+		return system;
+	}
+
+	//n polynomials in n variables of total degree at most degree, with coefficients in
+	//[-3,3]: every monomial if terms is 0, otherwise that many random ones and a constant
+	template <typename CoefT>
+	static std::vector<Polynomial<CoefT>> random(int n, int degree, int terms, unsigned seed)
+	{
+		std::mt19937 generator(seed);
+		auto coefficient = [&]() { return static_cast<int>(generator() % 7) - 3; };
+
+		//every exponent vector of total degree at most degree
+		std::vector<std::vector<int>> monomials{ std::vector<int>(n) };
+		for (size_t first = 0; first < monomials.size(); ++first)
+		{
+			int total = 0;
+			for (int d : monomials[first])
+				total += d;
+			if (total == degree)
+				continue;
+			//raise only from the last nonzero variable onwards, so each is made once
+			int last = n - 1;
+			while (last > 0 && monomials[first][last] == 0)
+				--last;
+			for (int i = last; i < n; ++i)
+			{
+				monomials.push_back(monomials[first]);
+				++monomials.back()[i];
+			}
+		}
+
+		std::vector<Polynomial<CoefT>> system;
+		for (int k = 0; k < n; ++k)
+		{
+			Polynomial<CoefT> p = coefficient() + 4; //a nonzero constant
+			if (terms == 0)
+				for (const auto& degrees : monomials)
+					p += coefficient() * Polynomial<CoefT>(PowerProduct(degrees));
+			else
+				for (int t = 0; t < terms; ++t)
+					p += coefficient() * Polynomial<CoefT>(PowerProduct(monomials[generator() % monomials.size()]));
+			system.push_back(p);
+		}
+		return system;
+	}
+};
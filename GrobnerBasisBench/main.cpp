@@ -0,0 +1,372 @@
+/*
+Notes: Each case runs in a child process where fork is available, so its peak memory is its
+own and a case that runs past the time limit can be killed without losing the rest. Elsewhere
+cases run in this process, the peak memory is the whole run's so far, and there is no limit.
+*/
+#include "Workloads.h"
+#include "Ideal.h"
+#include "CoefficientCodec.h"
+#include "LexTermOrder.h"
+#include "DegLexTermOrder.h"
+#include "DegRevLexTermOrder.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+const std::string usage =
+"Usage: GrobnerBasisBench [options]\n"
+"Computes reduced Grobner bases of standard systems and writes the results as JSON.\n\n"
+"  --family NAMES        families to run, separated by commas (default all):\n"
+"                        cyclic, katsura, eco, noon, random-dense, random-sparse\n"
+"  --size N              size of every family (default a few seconds' worth of each)\n"
+"  --order NAMES         term orders: lex, deglex, degrevlex (default all)\n"
+"  --coefficients NAMES  coefficient types: rational32, rational64, double\n"
+"                        (default rational64,double)\n"
+"  --threads N           threads per computation, 0 for every hardware thread (default 1)\n"
+"  --repeat N            times to compute each basis (default 3)\n"
+"  --timeout SECONDS     time limit for each case, where supported (default 30)\n"
+"  --seed N              seed for the random families (default 1)\n"
+"  --output FILE         write the JSON to FILE instead of standard output\n";
+
+// One family, size, term order, and coefficient type to benchmark.
+struct Case
+{
+	std::string family;
+	int size;
+	std::string order;
+	std::string coefficients;
+};
+
+// The measurements of a case.
+struct Result
+{
+	std::string status{ "ok" }; //or "timeout", "killed: SIGNAL", or "error: MESSAGE"
+	std::vector<double> seconds; //of each repetition
+	size_t pairsCreated{ 0 };
+	size_t pairsPruned{ 0 };
+	size_t pairsReduced{ 0 };
+	size_t zeroReductions{ 0 };
+	size_t reductionSteps{ 0 };
+	int maxCoefficientBits{ 0 };
+	size_t basisSize{ 0 };
+	long long peakMemoryKiB{ -1 };
+};
+
+// The options from the command line.
+struct Options
+{
+	std::vector<std::string> families = Workloads::families();
+	int size{ 0 }; //0 for each family's default
+	std::vector<std::string> orders{ "lex", "deglex", "degrevlex" };
+	std::vector<std::string> coefficients{ "rational64", "double" };
+	unsigned threads{ 1 };
+	int repeat{ 3 };
+	unsigned timeout{ 30 };
+	unsigned seed{ 1 };
+	std::string output;
+};
+
+//split a comma separated list
+std::vector<std::string> splitList(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::istringstream ss(list);
+	for (std::string item; std::getline(ss, item, ',');)
+		if (!item.empty())
+			items.push_back(item);
+	return items;
+}
+
+std::unique_ptr<PowerProduct::TermOrder> makeTermOrder(const std::string& name)
+{
+	if (name == "lex")
+		return std::make_unique<LexTermOrder>();
+	if (name == "deglex")
+		return std::make_unique<DegLexTermOrder>();
+	if (name == "degrevlex")
+		return std::make_unique<DegRevLexTermOrder>();
+	throw std::invalid_argument("unknown term order " + name);
+}
+
+//compute the basis repeat times, with coefficients of type CoefT
+template <typename CoefT>
+Result measure(const Case& c, const Options& options)
+{
+	Result result;
+	auto generators = Workloads::generate<CoefT>(c.family, c.size, options.seed);
+	for (int r = 0; r < options.repeat; ++r)
+	{
+		Ideal<CoefT> ideal;
+		ideal.setThreadCount(options.threads);
+		ideal.setTermOrder(makeTermOrder(c.order));
+		ideal.setStatisticsEnabled(true);
+		auto start = std::chrono::steady_clock::now();
+		ideal.setGenerators(generators.begin(), generators.end());
+		result.seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+		const auto& stats = ideal.statistics();
+		result.pairsCreated = stats.pairsCreated;
+		result.pairsPruned = stats.pairsPruned;
+		result.pairsReduced = stats.pairsReduced;
+		result.zeroReductions = stats.zeroReductions;
+		result.reductionSteps = stats.reductionSteps;
+		result.maxCoefficientBits = stats.maxCoefficientBits;
+		result.basisSize = std::distance(ideal.begin(), ideal.end());
+	}
+	return result;
+}
+
+Result measure(const Case& c, const Options& options)
+{
+	if (c.coefficients == "rational32")
+		return measure<Rational<int>>(c, options);
+	if (c.coefficients == "rational64")
+		return measure<Rational<long long>>(c, options);
+	if (c.coefficients == "double")
+		return measure<double>(c, options);
+	throw std::invalid_argument("unknown coefficient type " + c.coefficients);
+}
+
+#ifdef _WIN32
+Result run(const Case& c, const Options& options)
+{
+	Result result;
+	try
+	{
+		result = measure(c, options);
+	}
+	catch (std::exception& ex)
+	{
+		result.status = std::string("error: ") + ex.what();
+	}
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters))
+		result.peakMemoryKiB = static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+	return result;
+}
+#else
+Result run(const Case& c, const Options& options)
+{
+	//the child writes its measurements as text to a pipe
+	int fds[2];
+	if (pipe(fds) != 0)
+		throw std::runtime_error("cannot create pipe");
+	std::cout.flush();
+	pid_t child = fork();
+	if (child < 0)
+		throw std::runtime_error("cannot fork");
+	if (child == 0)
+	{
+		close(fds[0]);
+		alarm(options.timeout);
+		std::ostringstream ss;
+		try
+		{
+			Result result = measure(c, options);
+			ss << "ok " << result.pairsCreated << ' ' << result.pairsPruned << ' ' << result.pairsReduced << ' '
+				<< result.zeroReductions << ' ' << result.reductionSteps << ' ' << result.maxCoefficientBits << ' '
+				<< result.basisSize;
+			for (double s : result.seconds)
+				ss << ' ' << s;
+		}
+		catch (std::exception& ex)
+		{
+			ss << "error " << ex.what();
+		}
+		std::string message = ss.str();
+		for (size_t written = 0; written < message.size();)
+		{
+			ssize_t n = write(fds[1], message.data() + written, message.size() - written);
+			if (n <= 0)
+				break;
+			written += n;
+		}
+		_exit(0);
+	}
+
+	close(fds[1]);
+	std::string message;
+	char buffer[4096];
+	for (ssize_t n; (n = read(fds[0], buffer, sizeof buffer)) != 0;)
+		if (n > 0)
+			message.append(buffer, n);
+		else if (errno != EINTR)
+			break;
+	close(fds[0]);
+	int status;
+	struct rusage usage;
+	while (wait4(child, &status, 0, &usage) < 0 && errno == EINTR) {}
+
+	Result result;
+#ifdef __APPLE__
+	result.peakMemoryKiB = usage.ru_maxrss / 1024; //bytes
+#else
+	result.peakMemoryKiB = usage.ru_maxrss; //kibibytes
+#endif
+	std::istringstream ss(message);
+	std::string word;
+	ss >> word;
+	if (WIFSIGNALED(status))
+		result.status = WTERMSIG(status) == SIGALRM ? "timeout" : std::string("killed: ") + strsignal(WTERMSIG(status));
+	else if (word == "ok")
+	{
+		ss >> result.pairsCreated >> result.pairsPruned >> result.pairsReduced >> result.zeroReductions
+			>> result.reductionSteps >> result.maxCoefficientBits >> result.basisSize;
+		for (double s; ss >> s;)
+			result.seconds.push_back(s);
+	}
+	else
+	{
+		std::getline(ss >> std::ws, word);
+		result.status = "error: " + word;
+	}
+	return result;
+}
+#endif
+
+//a JSON string literal
+std::string quote(const std::string& s)
+{
+	std::ostringstream ss;
+	ss << '"';
+	for (char c : s)
+	{
+		if (c == '"' || c == '\\')
+			ss << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			ss << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xf] << "0123456789abcdef"[c & 0xf];
+		else
+			ss << c;
+	}
+	ss << '"';
+	return ss.str();
+}
+
+void writeResult(std::ostream& out, const Case& c, const Result& result)
+{
+	std::vector<double> sorted = result.seconds;
+	std::sort(sorted.begin(), sorted.end());
+	out << "    { \"family\": " << quote(c.family) << ", \"size\": " << c.size
+		<< ", \"order\": " << quote(c.order) << ", \"coefficients\": " << quote(c.coefficients)
+		<< ", \"status\": " << quote(result.status) << ",\n      \"seconds\": [";
+	for (size_t i = 0; i < result.seconds.size(); ++i)
+		out << (i == 0 ? "" : ", ") << result.seconds[i];
+	out << "]";
+	if (!sorted.empty())
+		out << ", \"minSeconds\": " << sorted.front() << ", \"medianSeconds\": " << sorted[sorted.size() / 2];
+	out << ",\n      \"pairsCreated\": " << result.pairsCreated << ", \"pairsPruned\": " << result.pairsPruned
+		<< ", \"pairsReduced\": " << result.pairsReduced << ", \"zeroReductions\": " << result.zeroReductions
+		<< ", \"reductionSteps\": " << result.reductionSteps << ", \"maxCoefficientBits\": " << result.maxCoefficientBits
+		<< ", \"basisSize\": " << result.basisSize << ", \"peakMemoryKiB\": " << result.peakMemoryKiB << " }";
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+	Options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string option = argv[i];
+		if (option == "--help")
+		{
+			std::cout << usage;
+			std::exit(0);
+		}
+		if (i + 1 == argc)
+			throw std::invalid_argument("missing value for " + option);
+		std::string value = argv[++i];
+		if (option == "--family")
+			options.families = splitList(value);
+		else if (option == "--size")
+			options.size = std::stoi(value);
+		else if (option == "--order")
+			options.orders = splitList(value);
+		else if (option == "--coefficients")
+			options.coefficients = splitList(value);
+		else if (option == "--threads")
+			options.threads = std::stoul(value);
+		else if (option == "--repeat")
+			options.repeat = std::max(1, std::stoi(value));
+		else if (option == "--timeout")
+			options.timeout = std::stoul(value);
+		else if (option == "--seed")
+			options.seed = std::stoul(value);
+		else if (option == "--output")
+			options.output = value;
+		else
+			throw std::invalid_argument("unknown option " + option);
+	}
+	return options;
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	try
+	{
+		options = parseOptions(argc, argv);
+		for (const auto& family : options.families)
+			Workloads::generate<double>(family, options.size == 0 ? Workloads::defaultSize(family) : options.size);
+		for (const auto& order : options.orders)
+			makeTermOrder(order);
+		for (const auto& coefficients : options.coefficients)
+			if (coefficients != "rational32" && coefficients != "rational64" && coefficients != "double")
+				throw std::invalid_argument("unknown coefficient type " + coefficients);
+	}
+	catch (std::exception& ex)
+	{
+		std::cerr << "Error: " << ex.what() << "\n\n" << usage;
+		return 2;
+	}
+
+	std::ofstream file;
+	if (!options.output.empty())
+	{
+		file.open(options.output);
+		if (!file)
+		{
+			std::cerr << "Error: cannot open " << options.output << "\n";
+			return 1;
+		}
+	}
+	std::ostream& out = options.output.empty() ? std::cout : file;
+	out.precision(6);
+
+	out << "{\n  \"threads\": " << options.threads << ", \"repeat\": " << options.repeat
+		<< ", \"timeoutSeconds\": " << options.timeout << ", \"seed\": " << options.seed << ",\n  \"results\": [\n";
+	bool first = true;
+	for (const auto& family : options.families)
+		for (const auto& order : options.orders)
+			for (const auto& coefficients : options.coefficients)
+			{
+				Case c{ family, options.size == 0 ? Workloads::defaultSize(family) : options.size, order, coefficients };
+				std::cerr << c.family << '-' << c.size << ' ' << c.order << ' ' << c.coefficients << "... ";
+				Result result = run(c, options);
+				std::cerr << result.status << '\n';
+				if (!first)
+					out << ",\n";
+				first = false;
+				writeResult(out, c, result);
+				out.flush();
+			}
+	out << "\n  ]\n}\n";
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include "BasisCache.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	//first line of every entry; bump the version if the layout changes
+	const std::string entryHeader = "GrobnerBasisCache 2\n";
+	const std::string entryExtension = ".entry";
+	const std::string temporaryExtension = ".tmp";
+}
+
+BasisCache::BasisCache(fs::path directory, std::uintmax_t maxBytes, std::chrono::seconds maxAge)
+	: mDirectory{ std::move(directory) }, mMaxBytes{ maxBytes }, mMaxAge{ maxAge }
+{
+	fs::create_directories(mDirectory);
+}
+
+std::optional<std::string> BasisCache::load(const std::string& description) const
+{
+	//layout: header, description length, description, contents
+	fs::path path = entryPath(description);
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return std::nullopt;
+	std::ostringstream buffer;
+	buffer << file.rdbuf();
+	file.close();
+	std::string entry = buffer.str();
+
+	std::istringstream header(entry);
+	size_t length;
+	if (entry.compare(0, entryHeader.size(), entryHeader) != 0)
+		return std::nullopt;
+	header.seekg(entryHeader.size());
+	if (!(header >> length) || header.get() != '\n')
+		return std::nullopt;
+	size_t start = static_cast<size_t>(header.tellg());
+	if (entry.size() - start < length || entry.compare(start, length, description) != 0)
+		return std::nullopt; //truncated, or a different description with the same hash
+
+	std::error_code error;
+	fs::last_write_time(path, fs::file_time_type::clock::now(), error); //mark as used; harmless if it fails
+	return entry.substr(start + length);
+}
+
+void BasisCache::store(const std::string& description, const std::string& contents) const
+{
+	//write to a name no other writer will pick, then rename over the entry
+	fs::path path = entryPath(description);
+	std::random_device random;
+	std::ostringstream suffix;
+	suffix << '.' << std::hex << random() << random() << temporaryExtension;
+	fs::path temporary = path;
+	temporary += suffix.str();
+
+	{
+		std::ofstream file(temporary, std::ios::binary);
+		file << entryHeader << description.size() << '\n' << description << contents;
+		if (!file.flush())
+		{
+			file.close();
+			std::error_code error;
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	std::error_code error;
+	fs::rename(temporary, path, error);
+	if (error)
+		fs::remove(temporary, error);
+
+	evict();
+}
+
+void BasisCache::evict() const
+{
+	struct Entry
+	{
+		fs::path path;
+		fs::file_time_type used;
+		std::uintmax_t size;
+	};
+	std::vector<Entry> entries;
+	auto now = fs::file_time_type::clock::now();
+	std::uintmax_t total = 0;
+
+	//other processes may be adding and removing entries as we go, so every error is skipped
+	std::error_code error;
+	for (fs::directory_iterator it(mDirectory, error), end; !error && it != end; it.increment(error))
+	{
+		const fs::path& path = it->path();
+		auto extension = path.extension();
+		if (extension != entryExtension && extension != temporaryExtension)
+			continue;
+		std::error_code entryError;
+		auto used = fs::last_write_time(path, entryError);
+		if (entryError)
+			continue;
+		auto size = fs::file_size(path, entryError);
+		if (entryError)
+			continue;
+		if (now - used > mMaxAge) //also clears temporaries left by a writer that died
+			fs::remove(path, entryError);
+		else if (extension == entryExtension)
+		{
+			entries.push_back({ path, used, size });
+			total += size;
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const Entry& l, const Entry& r) { return l.used < r.used; }); //least recently used first
+	for (auto it = entries.begin(); it != entries.end() && total > mMaxBytes; ++it)
+	{
+		std::error_code entryError;
+		fs::remove(it->path, entryError);
+		total -= it->size;
+	}
+}
+
+std::uint64_t BasisCache::hash(const std::string& s)
+{
+	std::uint64_t h = 14695981039346656037ull; //FNV offset basis
+	for (unsigned char c : s)
+	{
+		h ^= c;
+		h *= 1099511628211ull; //FNV prime
+	}
+	return h;
+}
+
+fs::path BasisCache::entryPath(const std::string& description) const
+{
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << hash(description) << entryExtension;
+	return mDirectory / name.str();
+}
@@ -0,0 +1,54 @@
+/*
+Notes: Each entry is a file named by a hash of its description, which is also stored in
+the file and compared on load, so a hash collision costs only a miss. An entry is written
+under a temporary name and then renamed into place; the rename is atomic, so processes
+sharing the directory only ever see whole entries. A hit refreshes the entry's modification
+time, which eviction takes as its last use.
+*/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+// A directory of computed results, such as reduced Grobner bases, keyed by a description of
+// what was computed. Any number of threads and processes may share the directory. Entries
+// unused for longer than a maximum age are evicted, and then the least recently used ones
+// until the total size is within a maximum.
+class BasisCache final
+{
+public:
+	static constexpr std::uintmax_t defaultMaxBytes = 1ull << 30;
+	static constexpr std::chrono::hours defaultMaxAge{ 24 * 30 };
+
+	// Uses the given directory, creating it if needed.
+	explicit BasisCache(std::filesystem::path directory,
+		std::uintmax_t maxBytes = defaultMaxBytes, std::chrono::seconds maxAge = defaultMaxAge);
+
+	// Returns the contents stored under description, if any.
+	std::optional<std::string> load(const std::string& description) const;
+
+	// Stores contents under description, replacing any earlier contents, then evicts as needed.
+	// A failure to write is not an error; the contents are just not cached.
+	void store(const std::string& description, const std::string& contents) const;
+
+	// Removes the entries unused for longer than the maximum age, then the least recently
+	// used until the total size is within the maximum.
+	void evict() const;
+
+	// Returns the directory holding the entries.
+	const std::filesystem::path& directory() const { return mDirectory; }
+
+	// Returns the 64-bit FNV-1a hash of s.
+	static std::uint64_t hash(const std::string& s);
+
+private:
+	std::filesystem::path mDirectory;
+	std::uintmax_t mMaxBytes;
+	std::chrono::seconds mMaxAge;
+
+	//the file holding the entry for description
+	std::filesystem::path entryPath(const std::string& description) const;
+};
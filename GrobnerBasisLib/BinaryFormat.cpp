@@ -0,0 +1,140 @@
+#include "BinaryFormat.h"
+#include <algorithm>
+
+void BinaryFormat::Output::writeUnsigned(std::uint64_t value)
+{
+	//seven bits at a time, least significant first, with the high bit set on all but the last
+	char bytes[10];
+	size_t count = 0;
+	do
+	{
+		bytes[count] = static_cast<char>(value & 0x7f);
+		value >>= 7;
+		if (value != 0)
+			bytes[count] |= 0x80;
+		++count;
+	} while (value != 0);
+	mOut.write(bytes, count);
+}
+
+void BinaryFormat::Output::writeSigned(std::int64_t value)
+{
+	//zigzag: 0,-1,1,-2,... become 0,1,2,3,..., so small magnitudes stay short
+	std::uint64_t bits = static_cast<std::uint64_t>(value);
+	writeUnsigned((bits << 1) ^ (value < 0 ? ~std::uint64_t(0) : 0));
+}
+
+void BinaryFormat::Output::writeFixed(std::uint64_t value)
+{
+	char bytes[8];
+	for (char& byte : bytes)
+	{
+		byte = static_cast<char>(value & 0xff);
+		value >>= 8;
+	}
+	mOut.write(bytes, 8);
+}
+
+void BinaryFormat::Output::writeString(const std::string& value)
+{
+	writeUnsigned(value.size());
+	mOut.write(value.data(), value.size());
+}
+
+void BinaryFormat::Output::writeHeader(const Header& header)
+{
+	mOut.write(magic, sizeof magic);
+	writeUnsigned(version);
+	writeUnsigned(header.variables.size());
+	for (const auto& name : header.variables)
+		writeString(name);
+
+	size_t columns = header.termOrder.empty() ? 0 : header.termOrder.front().size();
+	writeUnsigned(header.termOrder.size());
+	writeUnsigned(columns);
+	for (const auto& row : header.termOrder)
+	{
+		if (row.size() != columns)
+			throw std::logic_error("term order matrix is not rectangular");
+		for (long long weight : row)
+			writeSigned(weight);
+	}
+	writeString(header.coefficients);
+}
+
+std::uint64_t BinaryFormat::Input::readUnsigned()
+{
+	std::uint64_t value = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		if (mNext == mLast)
+			throw FormatException("unexpected end of input");
+		unsigned char byte = static_cast<unsigned char>(*mNext++);
+		if (shift == 63 && byte > 1)
+			throw FormatException("integer too large");
+		value |= std::uint64_t(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+}
+
+std::int64_t BinaryFormat::Input::readSigned()
+{
+	std::uint64_t bits = readUnsigned();
+	return static_cast<std::int64_t>((bits >> 1) ^ (bits & 1 ? ~std::uint64_t(0) : 0));
+}
+
+std::uint64_t BinaryFormat::Input::readFixed()
+{
+	if (mLast - mNext < 8)
+		throw FormatException("unexpected end of input");
+	std::uint64_t value = 0;
+	for (int i = 7; i >= 0; --i)
+		value = (value << 8) | static_cast<unsigned char>(mNext[i]);
+	mNext += 8;
+	return value;
+}
+
+std::uint64_t BinaryFormat::Input::readUnsigned(std::uint64_t max, const char* what)
+{
+	std::uint64_t value = readUnsigned();
+	if (value > max)
+		throw FormatException(std::string(what) + " out of range");
+	return value;
+}
+
+std::string BinaryFormat::Input::readString()
+{
+	std::uint64_t length = readUnsigned();
+	if (length > static_cast<std::uint64_t>(mLast - mNext))
+		throw FormatException("unexpected end of input");
+	std::string value(mNext, static_cast<size_t>(length));
+	mNext += length;
+	return value;
+}
+
+BinaryFormat::Header BinaryFormat::Input::readHeader()
+{
+	if (mLast - mNext < static_cast<std::ptrdiff_t>(sizeof magic) || !std::equal(magic, magic + sizeof magic, mNext))
+		throw FormatException("not a binary polynomial file");
+	mNext += sizeof magic;
+	if (readUnsigned() != version)
+		throw FormatException("unsupported format version");
+
+	//every count is bounded by the bytes left, so a damaged count cannot exhaust memory
+	Header header;
+	header.variables.resize(static_cast<size_t>(readUnsigned(mLast - mNext, "variable count")));
+	for (auto& name : header.variables)
+		name = readString();
+
+	size_t rows = static_cast<size_t>(readUnsigned(mLast - mNext, "term order rows"));
+	size_t columns = static_cast<size_t>(readUnsigned(mLast - mNext, "term order columns"));
+	if (rows != 0 && columns > static_cast<size_t>(mLast - mNext) / rows)
+		throw FormatException("term order matrix out of range");
+	header.termOrder.assign(rows, std::vector<long long>(columns));
+	for (auto& row : header.termOrder)
+		for (long long& weight : row)
+			weight = readSigned();
+	header.coefficients = readString();
+	return header;
+}
@@ -0,0 +1,81 @@
+/*
+Notes: The layout of a file, with every integer a LEB128 varint (signed ones zigzag-encoded):
+	the magic bytes "GRBN" and the format version
+	the number of variable names, then each name as a length and its bytes
+	the number of rows and columns of the term order matrix, then its entries row by row
+	the name of the coefficient type, as a length and its bytes
+	for each polynomial: its number of terms plus one, the number of variables it uses,
+	its exponent block (that many degrees for each term), and its coefficient block (one
+	coefficient for each term, encoded by CoefficientCodec)
+	a zero in place of a number of terms, marking the end
+Terms are written in increasing lex order, the order Polynomial keeps them in, so they can
+be read back without sorting.
+*/
+
+#pragma once
+#include "PowerProduct.h"
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Low-level reading and writing of the binary format for polynomials and ideals.
+// See BinaryWriter and BinaryReader for writing and reading whole files.
+class BinaryFormat final
+{
+public:
+	static constexpr char magic[4] = { 'G','R','B','N' };
+	static constexpr std::uint64_t version = 1;
+
+	// Indicates that the input is not in the binary format, or is damaged or truncated.
+	class FormatException : public std::runtime_error {
+	public:
+		explicit FormatException(std::string message) : std::runtime_error(message) {}
+	};
+
+	// What a file holds besides the polynomials.
+	struct Header
+	{
+		std::vector<std::string> variables; //names, possibly none
+		PowerProduct::TermOrder::Matrix termOrder; //possibly empty
+		std::string coefficients; //the name of the coefficient type
+	};
+
+	// Writes the format to a stream as it goes.
+	class Output
+	{
+	public:
+		explicit Output(std::ostream& out) : mOut{ out } {}
+
+		void writeUnsigned(std::uint64_t value);
+		void writeSigned(std::int64_t value);
+		void writeFixed(std::uint64_t value); //8 bytes, little-endian
+		void writeString(const std::string& value);
+		void writeHeader(const Header& header);
+
+	private:
+		std::ostream& mOut;
+	};
+
+	// Reads the format from a range of bytes in memory, such as a MappedFile, without
+	// copying it. Throws FormatException on reading past the end or a malformed value.
+	class Input
+	{
+	public:
+		Input(const char* first, const char* last) : mNext{ first }, mLast{ last } {}
+
+		std::uint64_t readUnsigned();
+		std::int64_t readSigned();
+		std::uint64_t readFixed();
+		std::string readString();
+		Header readHeader();
+
+		// Reads an unsigned value that must be at most max, such as a count.
+		std::uint64_t readUnsigned(std::uint64_t max, const char* what);
+
+	private:
+		const char* mNext;
+		const char* mLast;
+	};
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "BinaryFormat.h"
+#include "CoefficientCodec.h"
+#include "Polynomial.h"
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Reads polynomials in the binary format (see BinaryFormat) from a range of bytes in memory,
+// such as a MappedFile, decoding each term straight into the polynomial. Throws
+// BinaryFormat::FormatException if the bytes are not a file written for coefficients of type CoefT.
+template <typename CoefT>
+class BinaryReader final
+{
+public:
+	// Reads the header from the bytes in [data,data+size), which must outlive the reader.
+	BinaryReader(const char* data, size_t size)
+		: mIn{ data, data + size }, mHeader{ mIn.readHeader() }, mBytes{ size }
+	{
+		if (mHeader.coefficients != CoefficientCodec<CoefT>::name())
+			throw BinaryFormat::FormatException("coefficients are " + mHeader.coefficients
+				+ ", not " + CoefficientCodec<CoefT>::name());
+	}
+
+	// Returns the header.
+	const BinaryFormat::Header& header() const { return mHeader; }
+
+	// Reads the next polynomial into p, or returns false if there are no more.
+	bool read(Polynomial<CoefT>& p)
+	{
+		if (mDone)
+			return false;
+		size_t terms = static_cast<size_t>(mIn.readUnsigned(mBytes, "term count"));
+		if (terms-- == 0)
+		{
+			mDone = true;
+			return false;
+		}
+		size_t variables = static_cast<size_t>(mIn.readUnsigned(mBytes, "variable count"));
+		if (terms != 0 && variables > mBytes / terms)
+			throw BinaryFormat::FormatException("exponent block out of range");
+
+		std::vector<int> degrees(terms * variables);
+		for (int& degree : degrees)
+			degree = static_cast<int>(mIn.readUnsigned(std::numeric_limits<int>::max(), "degree"));
+		std::vector<std::pair<PowerProduct, CoefT>> termList;
+		termList.reserve(terms);
+		for (size_t t = 0; t < terms; ++t)
+		{
+			auto first = degrees.begin() + t * variables;
+			termList.emplace_back(PowerProduct(std::vector<int>(first, first + variables)),
+				CoefficientCodec<CoefT>::read(mIn));
+		}
+		p = Polynomial<CoefT>(termList.begin(), termList.end());
+		return true;
+	}
+
+private:
+	BinaryFormat::Input mIn;
+	BinaryFormat::Header mHeader;
+	size_t mBytes; //bounds every count, so a damaged one cannot exhaust memory
+	bool mDone{ false };
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "BinaryFormat.h"
+#include "CoefficientCodec.h"
+#include "Polynomial.h"
+#include <algorithm>
+#include <ostream>
+
+// Writes polynomials to a stream in the binary format (see BinaryFormat), one at a time,
+// so the whole file never has to be held in memory. Call finish after the last one.
+template <typename CoefT>
+class BinaryWriter final
+{
+public:
+	// Writes the header; its coefficient type name is filled in from CoefficientCodec.
+	BinaryWriter(std::ostream& out, BinaryFormat::Header header)
+		: mOut{ out }
+	{
+		header.coefficients = CoefficientCodec<CoefT>::name();
+		mOut.writeHeader(header);
+	}
+
+	// Writes a polynomial.
+	void write(const Polynomial<CoefT>& p)
+	{
+		size_t variables = 0;
+		for (const auto& term : p)
+			variables = std::max(variables, term.first.variables());
+
+		mOut.writeUnsigned(p.size() + 1);
+		mOut.writeUnsigned(variables);
+		for (const auto& term : p) //exponent block
+			for (size_t n = 0; n < variables; ++n)
+				mOut.writeUnsigned(term.first.degree(n));
+		for (const auto& term : p) //coefficient block
+			CoefficientCodec<CoefT>::write(mOut, term.second);
+	}
+
+	// Marks the end of the polynomials.
+	void finish() { mOut.writeUnsigned(0); }
+
+private:
+	BinaryFormat::Output mOut;
+};
@@ -0,0 +1,19 @@
+#include "Budget.h"
+#include <string>
+
+void Budget::exceed(Reason reason, size_t limit)
+{
+	switch (reason)
+	{
+	case Cancelled:
+		throw ExceededException(reason, "computation cancelled");
+	case Deadline:
+		throw ExceededException(reason, "deadline passed");
+	case Pairs:
+		throw ExceededException(reason, "budget of " + std::to_string(limit) + " critical pairs exceeded");
+	case BasisSize:
+		throw ExceededException(reason, "budget of " + std::to_string(limit) + " basis elements exceeded");
+	default:
+		throw ExceededException(reason, "memory budget of " + std::to_string(limit) + " bytes exceeded");
+	}
+}
@@ -0,0 +1,106 @@
+/*
+Notes: A Budget is checked by the computations it is given to at safe points: between
+reduction steps, before each batch of critical pairs, and after each new basis element.
+Only cancel may be called while a computation is checking the budget; the limits are set
+beforehand. Cancelling is sticky, so a cancelled budget stops every later computation too.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// Limits on a computation, and a token to cancel it from another thread. When the budget
+// runs out the computation throws ExceededException.
+class Budget final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// What ran out.
+	enum Reason
+	{
+		Cancelled, // cancel was called
+		Deadline, // the deadline passed
+		Pairs, // too many critical pairs were reduced
+		BasisSize, // the basis grew too large
+		Memory // too much memory was counted
+	};
+
+	// Thrown by a computation whose budget ran out.
+	class ExceededException : public std::runtime_error
+	{
+	public:
+		ExceededException(Reason reason, const std::string& message)
+			: std::runtime_error(message), mReason{ reason } {}
+
+		// Returns what ran out.
+		Reason reason() const { return mReason; }
+	private:
+		Reason mReason;
+	};
+
+	// Constructs a budget with no limits.
+	Budget() = default;
+	Budget(const Budget&) = delete;
+	Budget& operator=(const Budget&) = delete;
+
+	// Sets the time after which computations stop, or the time from now.
+	void setDeadline(Clock::time_point deadline) { mDeadline = deadline; mHasDeadline = true; }
+	void setTimeLimit(Clock::duration limit) { setDeadline(Clock::now() + limit); }
+
+	// Sets the most critical pairs a computation of a basis may reduce; 0 for no limit.
+	void setMaxPairs(size_t pairs) { mMaxPairs = pairs; }
+
+	// Sets the most elements a basis may have while it is computed; 0 for no limit.
+	void setMaxBasisSize(size_t elements) { mMaxBasisSize = elements; }
+
+	// Sets the most bytes of memory a computation may have in use, as counted by
+	// Ideal::memory(); 0 for no limit. Unlike Ideal::setMemoryLimit, this is only checked at
+	// safe points, so it may be overshot by the memory of one step.
+	void setMaxMemory(size_t bytes) { mMaxMemory = bytes; }
+
+	size_t maxPairs() const { return mMaxPairs; }
+	size_t maxBasisSize() const { return mMaxBasisSize; }
+	size_t maxMemory() const { return mMaxMemory; }
+
+	// Stops the computations checking this budget, from any thread.
+	void cancel() { mCancelled.store(true, std::memory_order_relaxed); }
+
+	// Returns true if cancel has been called.
+	bool cancelled() const { return mCancelled.load(std::memory_order_relaxed); }
+
+	// Throws ExceededException if the budget has been cancelled or the deadline has passed.
+	void check() const
+	{
+		if (cancelled())
+			exceed(Cancelled, 0);
+		if (mHasDeadline && Clock::now() >= mDeadline)
+			exceed(Deadline, 0);
+	}
+
+	// As check, and also throws if pairs, basisSize or memory (in bytes) is over its limit.
+	void check(size_t pairs, size_t basisSize, size_t memory) const
+	{
+		check();
+		if (mMaxPairs != 0 && pairs > mMaxPairs)
+			exceed(Pairs, mMaxPairs);
+		if (mMaxBasisSize != 0 && basisSize > mMaxBasisSize)
+			exceed(BasisSize, mMaxBasisSize);
+		if (mMaxMemory != 0 && memory > mMaxMemory)
+			exceed(Memory, mMaxMemory);
+	}
+
+private:
+	std::atomic<bool> mCancelled{ false };
+	bool mHasDeadline{ false };
+	Clock::time_point mDeadline;
+	size_t mMaxPairs{ 0 };
+	size_t mMaxBasisSize{ 0 };
+	size_t mMaxMemory{ 0 };
+
+	//throw for reason, whose limit is limit
+	[[noreturn]] static void exceed(Reason reason, size_t limit);
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include "BinaryFormat.h"
+#include "Rational.h"
+#include <cstring>
+#include <limits>
+#include <string>
+
+// How coefficients of type CoefT are written in the binary format (see BinaryFormat).
+// A specialization provides name(), which is recorded in the header so a file is only read
+// back as the type it was written with, and write and read for single coefficients.
+// Ideal requires one for its coefficient type.
+template <typename CoefT>
+struct CoefficientCodec;
+
+// Rationals are written as a signed numerator and an unsigned denominator, so the common
+// small ones take two or three bytes.
+template <typename Integer>
+struct CoefficientCodec<Rational<Integer>>
+{
+	static std::string name() { return "rational" + std::to_string(std::numeric_limits<Integer>::digits + 1); }
+
+	static void write(BinaryFormat::Output& out, const Rational<Integer>& c)
+	{
+		out.writeSigned(c.numerator());
+		out.writeUnsigned(static_cast<std::uint64_t>(c.denominator()));
+	}
+
+	static Rational<Integer> read(BinaryFormat::Input& in)
+	{
+		std::int64_t numerator = in.readSigned();
+		std::uint64_t denominator = in.readUnsigned(std::numeric_limits<Integer>::max(), "denominator");
+		if (numerator < std::numeric_limits<Integer>::min() || numerator > std::numeric_limits<Integer>::max())
+			throw BinaryFormat::FormatException("numerator out of range");
+		if (denominator == 0)
+			throw BinaryFormat::FormatException("zero denominator");
+		return Rational<Integer>(static_cast<Integer>(numerator), static_cast<Integer>(denominator));
+	}
+};
+
+// Doubles are written as their 8 bytes, exactly.
+template <>
+struct CoefficientCodec<double>
+{
+	static std::string name() { return "double"; }
+
+	static void write(BinaryFormat::Output& out, double c)
+	{
+		std::uint64_t bits;
+		std::memcpy(&bits, &c, sizeof bits);
+		out.writeFixed(bits);
+	}
+
+	static double read(BinaryFormat::Input& in)
+	{
+		std::uint64_t bits = in.readFixed();
+		double c;
+		std::memcpy(&c, &bits, sizeof c);
+		return c;
+	}
+};
@@ -3,7 +3,7 @@
 #include <algorithm>
 using namespace std;
 
-bool DegLexTermOrder::compare(const vector<int>& lDegrees, const vector<int>& rDegrees) const
+bool DegLexTermOrder::compare(const PowerProduct::Degrees& lDegrees, const PowerProduct::Degrees& rDegrees) const
 {
 	int lTotalDegree = accumulate(lDegrees.begin(), lDegrees.end(), 0); //sum of degrees
 	int rTotalDegree = accumulate(rDegrees.begin(), rDegrees.end(), 0); 
@@ -13,4 +13,15 @@ bool DegLexTermOrder::compare(const vector<int>& lDegrees, const vector<int>& rD
 		lDegrees.begin(), lDegrees.end(),
 		rDegrees.begin(), rDegrees.end()
 	);
-}
\ No newline at end of file
+}
+
+PowerProduct::TermOrder::Matrix DegLexTermOrder::matrix(size_t n) const
+{
+	Matrix rows{ vector<long long>(n, 1) }; //total degree
+	for (size_t i = 0; i < n; ++i) //then lex
+	{
+		rows.emplace_back(n);
+		rows.back()[i] = 1;
+	}
+	return rows;
+}
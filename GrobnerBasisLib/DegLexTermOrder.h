@@ -11,7 +11,12 @@ Date: 5/12/2022
 class DegLexTermOrder final :
     public PowerProduct::TermOrder
 {
+public:
+    // The all-ones row (total degree), then the identity (lex).
+    Matrix matrix(size_t n) const override;
+
+private:
     //compare vectors of degrees
-    bool compare(const std::vector<int>& degrees, const std::vector<int>& otherDegrees) const override;
+    bool compare(const PowerProduct::Degrees& degrees, const PowerProduct::Degrees& otherDegrees) const override;
 };
 
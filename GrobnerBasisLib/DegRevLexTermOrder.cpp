@@ -2,7 +2,7 @@
 #include <algorithm>
 #include <numeric>
 
-bool DegRevLexTermOrder::compare(const std::vector<int>& lDegrees, const std::vector<int>& rDegrees) const
+bool DegRevLexTermOrder::compare(const PowerProduct::Degrees& lDegrees, const PowerProduct::Degrees& rDegrees) const
 {
 	int lTotalDegree = accumulate(lDegrees.begin(), lDegrees.end(), 0); //sum of degrees
 	int rTotalDegree = accumulate(rDegrees.begin(), rDegrees.end(), 0);
@@ -17,3 +17,14 @@ bool DegRevLexTermOrder::compare(const std::vector<int>& lDegrees, const std::ve
 		lDegrees.rbegin(), lDegrees.rend()
 	);
 }
+
+PowerProduct::TermOrder::Matrix DegRevLexTermOrder::matrix(size_t n) const
+{
+	Matrix rows{ std::vector<long long>(n, 1) }; //total degree
+	for (size_t i = n; i-- > 1; ) //then the least degree in the last variable is greatest
+	{
+		rows.emplace_back(n);
+		rows.back()[i] = -1;
+	}
+	return rows;
+}
@@ -3,5 +3,10 @@
 class DegRevLexTermOrder
 	: public PowerProduct::TermOrder
 {
-	bool compare(const std::vector<int>& lDegrees, const std::vector<int>& rDegrees) const override;
+public:
+	// The all-ones row (total degree), then minus each unit row from the last variable back.
+	Matrix matrix(size_t n) const override;
+
+private:
+	bool compare(const PowerProduct::Degrees& lDegrees, const PowerProduct::Degrees& rDegrees) const override;
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+Notes: The file is split in one serial scan, which only looks for separators and counts
+lines, so it is cheap next to the parsing that follows on the pool. Errors are collected
+for every item and the first in the file is reported, so the outcome does not depend on
+which thread got there first.
+*/
+
+#pragma once
+#include "Parser.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Parses a file of items separated by commas or newlines, such as the generators of an
+// ideal, with a Parser. The file is mapped into memory and the items are parsed in
+// parallel. Blank items, such as empty lines, are skipped.
+template <typename T>
+class FileParser final
+{
+public:
+	using ParseException = typename Parser<T>::ParseException;
+
+	// Uses parser for each item, on pool if it is not null. parser must be safe to call
+	// from several threads at once.
+	explicit FileParser(const Parser<T>& parser, std::shared_ptr<ThreadPool> pool = nullptr)
+		: mParser{ parser }, pPool{ std::move(pool) } {}
+
+	// Parses the items in the file, in order. If an item cannot be parsed, throws a
+	// ParseException for the first such item, with a message beginning "FILE:LINE:COLUMN: "
+	// and its position in the file. Throws std::system_error if the file cannot be read.
+	std::vector<T> parse(const std::filesystem::path& path) const;
+
+private:
+	const Parser<T>& mParser;
+	std::shared_ptr<ThreadPool> pPool;
+
+	//an item: where it starts and ends in the file, and on which line
+	struct Item
+	{
+		size_t first;
+		size_t last;
+		size_t line; //counting from 1
+		size_t lineStart; //where its line starts in the file
+	};
+};
+
+template <typename T>
+std::vector<T> FileParser<T>::parse(const std::filesystem::path& path) const
+{
+	MappedFile file(path);
+	const char* data = file.data();
+
+	//split at each separator, skipping items that are only whitespace
+	std::vector<Item> items;
+	size_t line = 1, lineStart = 0, first = 0;
+	for (size_t i = 0; i <= file.size(); ++i)
+	{
+		if (i < file.size() && data[i] != ',' && data[i] != '\n')
+			continue;
+		if (std::any_of(data + first, data + i, [](char c) { return !std::isspace(static_cast<unsigned char>(c)); }))
+			items.push_back({ first, i, line, lineStart });
+		first = i + 1;
+		if (i < file.size() && data[i] == '\n')
+		{
+			++line;
+			lineStart = i + 1;
+		}
+	}
+
+	std::vector<T> results(items.size());
+	std::vector<std::unique_ptr<ParseException>> errors(items.size());
+	auto parseItem = [&](size_t i)
+	{
+		try
+		{
+			results[i] = mParser.parse(std::string(data + items[i].first, data + items[i].last));
+		}
+		catch (ParseException& ex)
+		{
+			errors[i] = std::make_unique<ParseException>(ex);
+		}
+	};
+	if (pPool)
+		pPool->forEach(items.size(), parseItem);
+	else
+		for (size_t i = 0; i < items.size(); ++i)
+			parseItem(i);
+
+	auto error = std::find_if(errors.begin(), errors.end(), [](const auto& e) { return e != nullptr; });
+	if (error != errors.end())
+	{
+		const Item& item = items[error - errors.begin()];
+		size_t position = item.first + ((*error)->position() == std::string::npos ? 0 : (*error)->position());
+		throw ParseException(path.string() + ":" + std::to_string(item.line) + ":"
+			+ std::to_string(position - item.lineStart + 1) + ": " + (*error)->what(), position);
+	}
+	return results;
+}
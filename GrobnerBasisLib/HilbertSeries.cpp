@@ -0,0 +1,202 @@
+#include "HilbertSeries.h"
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+	using Numerator = std::vector<long long>;
+
+	void trim(Numerator& n)
+	{
+		while (!n.empty() && n.back() == 0)
+			n.pop_back();
+	}
+
+	//drop the generators divisible by others, leaving the minimal generators of the ideal
+	void minimalize(std::vector<PowerProduct>& generators)
+	{
+		std::stable_sort(generators.begin(), generators.end(),
+			[](const PowerProduct& l, const PowerProduct& r) { return l.degree() < r.degree(); });
+		std::vector<PowerProduct> kept;
+		for (PowerProduct& g : generators)
+			if (std::none_of(kept.begin(), kept.end(), [&](const PowerProduct& k) { return g.isDivisibleBy(k); }))
+				kept.push_back(std::move(g));
+		generators = std::move(kept);
+	}
+
+	//the numerator of the series of the quotient by the ideal of generators, which are minimal
+	Numerator pivotNumerator(const std::vector<PowerProduct>& generators)
+	{
+		if (generators.empty())
+			return { 1 };
+		if (generators.front().degree() == 0) //1, so the whole ring
+			return {};
+
+		//the variable in the most generators, which are pairwise coprime if it is in just one
+		size_t variables = 0;
+		for (const PowerProduct& g : generators)
+			variables = std::max(variables, g.variables());
+		std::vector<size_t> counts(variables);
+		for (const PowerProduct& g : generators)
+			for (size_t n = 0; n < g.variables(); ++n)
+				counts[n] += g.degree(n) != 0;
+		size_t pivotVariable = std::max_element(counts.begin(), counts.end()) - counts.begin();
+
+		if (counts[pivotVariable] <= 1) //the product of 1 - t^deg(g)
+		{
+			Numerator product{ 1 };
+			for (const PowerProduct& g : generators)
+			{
+				int d = g.degree();
+				product.resize(product.size() + d);
+				for (size_t k = product.size(); k-- > size_t(d);)
+					product[k] -= product[k - d];
+			}
+			return product;
+		}
+
+		//the lower median of the variable's degrees; as a generator of its own it would be
+		//redundant, since a lesser power of it would divide the generators above the median
+		std::vector<int> degrees;
+		for (const PowerProduct& g : generators)
+			if (g.degree(pivotVariable) != 0)
+				degrees.push_back(g.degree(pivotVariable));
+		std::nth_element(degrees.begin(), degrees.begin() + (degrees.size() - 1) / 2, degrees.end());
+		int e = degrees[(degrees.size() - 1) / 2];
+		PowerProduct pivot = PowerProduct(pivotVariable).pow(e);
+
+		std::vector<PowerProduct> sum = generators; //M + (pivot)
+		sum.push_back(pivot);
+		minimalize(sum);
+		std::vector<PowerProduct> quotient; //M : pivot
+		for (const PowerProduct& g : generators)
+			quotient.push_back(g / PowerProduct(pivotVariable).pow(std::min(e, g.degree(pivotVariable))));
+		minimalize(quotient);
+
+		Numerator result = pivotNumerator(sum);
+		Numerator shifted = pivotNumerator(quotient);
+		result.resize(std::max(result.size(), shifted.size() + e));
+		for (size_t k = 0; k < shifted.size(); ++k)
+			result[k + e] += shifted[k];
+		trim(result);
+		return result;
+	}
+}
+
+HilbertSeries::HilbertSeries(std::vector<PowerProduct> generators, size_t variables)
+	: mVariables{ variables }
+{
+	for (const PowerProduct& g : generators)
+		mVariables = std::max(mVariables, g.variables());
+	minimalize(generators);
+	mNumerator = pivotNumerator(generators);
+}
+
+HilbertSeries::HilbertSeries(std::vector<long long> numerator, size_t variables)
+	: mNumerator{ std::move(numerator) }, mVariables{ variables }
+{
+	trim(mNumerator);
+}
+
+std::vector<long long> HilbertSeries::expand(size_t count) const
+{
+	//dividing by 1 - t takes partial sums
+	std::vector<long long> values(mNumerator.begin(), mNumerator.begin() + std::min(count, mNumerator.size()));
+	values.resize(count);
+	for (size_t i = 0; i < mVariables; ++i)
+		for (size_t k = 1; k < count; ++k)
+			values[k] += values[k - 1];
+	return values;
+}
+
+long long HilbertSeries::function(int degree) const
+{
+	return degree < 0 ? 0 : expand(degree + 1).back();
+}
+
+int HilbertSeries::dimension() const
+{
+	if (mNumerator.empty())
+		return -1;
+
+	//cancel factors of 1 - t: the numerator vanishes at 1 exactly when it has one, and then
+	//the partial sums of its coefficients are those of the quotient
+	Numerator n = mNumerator;
+	int pole = static_cast<int>(mVariables);
+	for (long long sum = 0; pole > 0; --pole)
+	{
+		sum = 0;
+		for (long long& c : n)
+			c = sum += c;
+		if (sum != 0)
+			break;
+		n.pop_back(); //the last partial sum is the value at 1
+	}
+	return pole;
+}
+
+long long HilbertSeries::degree() const
+{
+	if (mNumerator.empty())
+		return 0;
+	Numerator n = mNumerator;
+	for (size_t pole = mVariables; ; --pole)
+	{
+		long long atOne = 0;
+		for (long long c : n)
+			atOne += c;
+		if (atOne != 0 || pole == 0)
+			return atOne;
+		for (size_t k = 1; k < n.size(); ++k) //divide by 1 - t
+			n[k] += n[k - 1];
+		n.pop_back();
+	}
+}
+
+std::vector<long long> HilbertSeries::timesOneMinusT(size_t power) const
+{
+	Numerator n = mNumerator;
+	for (size_t i = 0; i < power; ++i)
+	{
+		n.push_back(0);
+		for (size_t k = n.size(); k-- > 1;)
+			n[k] -= n[k - 1];
+	}
+	trim(n);
+	return n;
+}
+
+bool HilbertSeries::operator==(const HilbertSeries& right) const
+{
+	//N/(1-t)^n == M/(1-t)^m exactly when N*(1-t)^m == M*(1-t)^n
+	return timesOneMinusT(right.mVariables) == right.timesOneMinusT(mVariables);
+}
+
+std::string HilbertSeries::toString() const
+{
+	std::ostringstream ss;
+	ss << '(';
+	bool first = true;
+	for (size_t k = 0; k < mNumerator.size(); ++k)
+	{
+		long long c = mNumerator[k];
+		if (c == 0)
+			continue;
+		if (!first)
+			ss << (c < 0 ? " - " : " + ");
+		else if (c < 0)
+			ss << '-';
+		first = false;
+		long long magnitude = c < 0 ? -c : c;
+		if (k == 0 || magnitude != 1)
+			ss << magnitude << (k == 0 ? "" : "*");
+		if (k == 1)
+			ss << 't';
+		else if (k > 1)
+			ss << "t^" << k;
+	}
+	if (first)
+		ss << '0';
+	ss << ")/(1-t)^" << mVariables;
+	return ss.str();
+}
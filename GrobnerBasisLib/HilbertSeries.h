@@ -0,0 +1,78 @@
+/*
+Notes: The Hilbert series of the quotient S/M of the polynomial ring S in n variables by a
+monomial ideal M is a rational function N(t)/(1-t)^n, where N has integer coefficients; its
+expansion gives the Hilbert function, the dimension of each degree of S/M. N is found by
+Bigatti's pivot algorithm: for a power product p, N(M) = N(M + (p)) + t^deg(p) * N(M : p),
+and both ideals on the right are simpler than M. The pivot is a power of the variable in the
+most generators, to the median of its degrees in them. The recursion ends at generators that
+are pairwise coprime, whose numerator is the product of the 1 - t^deg(g).
+
+A homogeneous ideal has the same Hilbert function as the ideal of the leading powers of its
+Grobner basis, in any term order, which is how Ideal computes it (see Ideal::hilbertSeries).
+*/
+
+#pragma once
+#include "PowerProduct.h"
+#include <string>
+#include <vector>
+
+// The Hilbert series of the quotient of a polynomial ring by a monomial ideal.
+class HilbertSeries final
+{
+public:
+	// Constructs the series of the whole polynomial ring in the given number of variables,
+	// 1/(1-t)^variables.
+	explicit HilbertSeries(size_t variables = 0) : mNumerator{ 1 }, mVariables{ variables } {}
+
+	// Constructs the series of the quotient by the monomial ideal generated by the power
+	// products in the range [first,last), in the given number of variables or the number
+	// present, whichever is greater.
+	template <typename PowerIterator>
+	HilbertSeries(PowerIterator first, PowerIterator last, size_t variables = 0)
+		: HilbertSeries(std::vector<PowerProduct>(first, last), variables) {}
+
+	// As above, for the power products in generators.
+	HilbertSeries(std::vector<PowerProduct> generators, size_t variables);
+
+	// Constructs the series N(t)/(1-t)^variables, with the coefficients of N given lowest
+	// degree first.
+	HilbertSeries(std::vector<long long> numerator, size_t variables);
+
+	// Returns the coefficients of the numerator N(t) of N(t)/(1-t)^n, lowest degree first,
+	// without trailing zeroes. Empty for the quotient by the whole ring.
+	const std::vector<long long>& numerator() const { return mNumerator; }
+
+	// Returns n, the number of variables of the ring.
+	size_t variables() const { return mVariables; }
+
+	// Returns the value of the Hilbert function at degree: the dimension of that degree of
+	// the quotient. 0 for negative degrees.
+	long long function(int degree) const;
+
+	// Returns the values of the Hilbert function at degrees 0 to count - 1.
+	std::vector<long long> expand(size_t count) const;
+
+	// Returns the Krull dimension of the quotient: the order of the pole of the series at
+	// t = 1. -1 for the quotient by the whole ring.
+	int dimension() const;
+
+	// Returns the degree (multiplicity) of the quotient: the numerator with the factors of
+	// 1 - t cancelled, at t = 1. 0 for the quotient by the whole ring.
+	long long degree() const;
+
+	// Returns true if both are the same rational function, even with different numbers of
+	// variables.
+	bool operator==(const HilbertSeries& right) const;
+	bool operator!=(const HilbertSeries& right) const { return !(*this == right); }
+
+	// Returns the series as text, such as (1 - 2*t^2 + t^4)/(1-t)^3.
+	std::string toString() const;
+
+private:
+	//coefficient of t^k at k, without trailing zeroes
+	std::vector<long long> mNumerator;
+	size_t mVariables;
+
+	//the numerator times (1-t)^power
+	std::vector<long long> timesOneMinusT(size_t power) const;
+};
@@ -6,17 +6,43 @@ injected into each Ideal to perform the necessary comparisons.
 */
 #pragma once
 #include "Polynomial.h"
+#include "Rational.h"
 #include "Printer.h"
-#include <list>
-#include <queue>
+#include "ThreadPool.h"
+#include "Tracer.h"
+#include "MemoryAccount.h"
+#include "NodePool.h"
+#include "Budget.h"
+#include "Progress.h"
+#include "HilbertSeries.h"
+#include "MatrixTermOrder.h"
+#include "BasisCache.h"
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include <vector>
+#include <deque>
 #include <algorithm>
 #include <memory>
 #include <sstream>
 #include <functional>
+#include <iterator>
+#include <map>
+#include <limits>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <type_traits>
+#include <utility>
 
 // An ideal of polynomials. Given a generating set, this class will
 // compute the reduced Grobner basis for it with respect to the given
 // term order. It can then decide membership and reduce polynomials with respect to this basis.
+// Const member functions may be called concurrently from any number of threads.
+// A copy has its own basis and statistics, and shares the rest: the term order (which is
+// never changed, only replaced), thread pool, cache, tracer, memory account, budget,
+// progress and expected Hilbert series. So a copy may compute a new basis on one thread
+// while the original answers questions on another.
+// CoefT must have a CoefficientCodec, used for caching and for reading and writing bases.
 template <class CoefT>
 class Ideal
 {
@@ -33,8 +59,11 @@ public:
 		: Ideal(first, last, std::make_unique<DefaultTermOrder>()) {}
 
 	// Constructs the ideal generated by the polynomials in the range [first,last).
+	// If a cache is given, the basis is looked up there before it is computed (see setCache).
 	template <typename PolyIterator>
-	Ideal(PolyIterator first, PolyIterator last, std::unique_ptr<PowerProduct::TermOrder> termOrder)
+	Ideal(PolyIterator first, PolyIterator last, std::unique_ptr<PowerProduct::TermOrder> termOrder,
+		std::shared_ptr<const BasisCache> cache = nullptr)
+		: pCache{ std::move(cache) }
 	{
 		for (auto it = first; it != last; ++it)
 			if (*it != 0)
@@ -50,151 +79,1057 @@ public:
 	Ideal(std::initializer_list<Polynomial<CoefT>> init, std::unique_ptr<PowerProduct::TermOrder> termOrder)
 		: Ideal(init.begin(), init.end(), std::move(termOrder)) { }
 
+	Ideal(const Ideal&) = default;
+	Ideal(Ideal&&) = default;
+	Ideal& operator=(Ideal&&) = default;
+
+	// Moves in a copy of right, so the old basis, which may be charged to the old memory
+	// account, is freed before the account can be.
+	Ideal& operator=(const Ideal& right) { return *this = Ideal(right); }
+
+	// The basis goes first, while the memory account it may be charged to still exists.
+	~Ideal() { mGrobner.clear(); }
+
+	// Changes the term order and recomputes the Grobner basis with respect to it.
+	// Once computed, a reduced basis is converted to the new order rather than recomputed
+	// with Buchberger's algorithm: by FGLM for a zero-dimensional ideal, and otherwise by the
+	// Grobner walk if both orders have matrix descriptions (see TermOrder::matrix). A
+	// homogeneous ideal is recomputed instead, driven by the Hilbert series of the basis in
+	// the old order (see setHilbertSeries), which skips most of the reductions.
 	void setTermOrder(std::unique_ptr<PowerProduct::TermOrder> termOrder) {
 		if (!termOrder)
 			throw std::logic_error("null term order");
-		pTermOrder = std::move(termOrder);
 
-		computeGrobnerBasis();
-		minimizeGrobnerBasis();
-		reduceGrobnerBasis();
+		if (mReduced && isZeroDimensional())
+		{
+			setPhase(Progress::Converting);
+			mGrobner = convertByFGLM(*termOrder); //needs the old order for normal forms
+			pTermOrder = std::move(termOrder);
+			updateLeading();
+		}
+		else if (mReduced && canWalkTo(*termOrder) && !isHomogeneous())
+		{
+			setPhase(Progress::Converting);
+			mGrobner = convertByWalk(*termOrder);
+			pTermOrder = std::move(termOrder);
+			updateLeading();
+		}
+		else
+		{
+			//a homogeneous ideal has the same Hilbert series in every order
+			std::unique_ptr<HilbertSeries> expected;
+			if (mReduced && isHomogeneous())
+				expected = std::make_unique<HilbertSeries>(hilbertSeries(variables()));
+
+			//restore the basis and order if the computation fails
+			Basis previous = mGrobner;
+			std::shared_ptr<const PowerProduct::TermOrder> previousOrder = std::exchange(pTermOrder, std::move(termOrder));
+			try
+			{
+				computeReducedGrobnerBasis(expected ? expected.get() : pHilbert.get());
+			}
+			catch (...)
+			{
+				mGrobner = std::move(previous);
+				pTermOrder = std::move(previousOrder);
+				updateLeading();
+				throw;
+			}
+		}
+		mReduced = true;
 	}
 
+	// Replaces the generators with the polynomials in the range [first,last), keeping the
+	// term order and thread count, and computes the new Grobner basis. If the computation
+	// throws, such as for the memory limit, the basis is left as it was; likewise for
+	// setTermOrder and addGenerators.
+	template <typename PolyIterator>
+	void setGenerators(PolyIterator first, PolyIterator last)
+	{
+		Basis generators;
+		for (auto it = first; it != last; ++it)
+			if (*it != 0)
+				generators.push_back(*it);
+		Basis previous = std::exchange(mGrobner, std::move(generators));
+
+		try
+		{
+			computeReducedGrobnerBasis(pHilbert.get());
+		}
+		catch (...) //keep the basis as it was
+		{
+			mGrobner = std::move(previous);
+			updateLeading();
+			throw;
+		}
+		mReduced = true;
+	}
+
+	// Adds the polynomials in the range [first,last) to the generators and updates the
+	// Grobner basis. The current basis is kept: only the pairs involving new elements are
+	// reduced, and only the elements whose tails the new leading terms can reduce are reduced again.
+	template <typename PolyIterator>
+	void addGenerators(PolyIterator first, PolyIterator last);
+
+	// Sets the number of threads used to compute Grobner bases: 1 (the default) computes
+	// serially, and 0 uses every hardware thread. The basis is not recomputed.
+	// The reduced basis does not depend on the thread count.
+	void setThreadCount(unsigned threadCount)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		pPool = threadCount > 1 ? std::make_shared<ThreadPool>(threadCount) : nullptr;
+	}
+
+	// Returns the number of threads used to compute Grobner bases.
+	unsigned threadCount() const { return pPool ? pPool->size() : 1; }
+
+	// Returns the thread pool used to compute Grobner bases, or null if computing serially.
+	// Other work may share it.
+	const std::shared_ptr<ThreadPool>& threadPool() const { return pPool; }
+
+	// Sets the cache of reduced bases, or null for none. Before the basis is computed from
+	// scratch it is looked up by its generators, term order, and coefficient type, and once
+	// computed it is stored. Only term orders with matrix descriptions are cached.
+	// The basis is not recomputed.
+	void setCache(std::shared_ptr<const BasisCache> cache) { pCache = std::move(cache); }
+
 	// Reduces p with respect to the Grobner basis of the ideal.
-	Polynomial<CoefT> reduce(Polynomial<CoefT> p) const;
+	Polynomial<CoefT> reduce(Polynomial<CoefT> p) const { return reduce(std::move(p), nullptr); }
 
-	// Returns true if p is a member of the ideal, i.e., reduce(p) == 0.
-	bool isMember(const Polynomial<CoefT>& p) const { return reduce(p) == 0; }
+	// Returns true if p is a member of the ideal, i.e., reduce(p) == 0. Stops as soon as
+	// a term is found that would be part of the remainder, without building the remainder.
+	bool isMember(Polynomial<CoefT> p) const;
+
+	// Returns true if p is a member of the ideal generated by the polynomials in the range
+	// [first,last), without necessarily computing its whole Grobner basis: p is tested
+	// against the partial basis as each element is found, and the answer is true as soon
+	// as p reduces to zero. Only a false answer requires finishing the basis.
+	template <typename PolyIterator>
+	static bool isMemberOf(PolyIterator first, PolyIterator last, const Polynomial<CoefT>& p)
+	{
+		return isMemberOf(first, last, p, std::make_unique<DefaultTermOrder>());
+	}
+
+	// As above, computing with respect to the given term order.
+	template <typename PolyIterator>
+	static bool isMemberOf(PolyIterator first, PolyIterator last, const Polynomial<CoefT>& p,
+		std::unique_ptr<PowerProduct::TermOrder> termOrder);
+
+	// Reduces each polynomial in the range [first,last), writing the results in order to out.
+	// The reductions are spread over the thread pool.
+	template <typename PolyIterator, typename OutputIterator>
+	OutputIterator reduceAll(PolyIterator first, PolyIterator last, OutputIterator out) const;
+
+	// Decides membership for each polynomial in the range [first,last), writing the answers
+	// (convertible to bool) in order to out. The tests are spread over the thread pool.
+	template <typename PolyIterator, typename OutputIterator>
+	OutputIterator isMemberAll(PolyIterator first, PolyIterator last, OutputIterator out) const;
 
 	// Returns true if other is contained in this ideal
 	bool contains(const Ideal& other) const 
 	{
-		return std::all_of(
-			other.mGrobner.cbegin(), other.mGrobner.cend(), 
-			[&](const auto& p) {return isMember(p); }
-		);
+		std::vector<char> members;
+		isMemberAll(other.mGrobner.cbegin(), other.mGrobner.cend(), std::back_inserter(members));
+		return std::all_of(members.begin(), members.end(), [](char member) { return member != 0; });
 	}
 
 	// Returns true if this and other are equal as sets of polynomials (term order is ignored).
 	bool equals(const Ideal& other) const { return contains(other) && other.contains(*this); }
 
+	// Returns true if the ideal is zero-dimensional, i.e., the quotient ring is a finite-dimensional
+	// vector space: some power of every variable present is a leading power in the basis.
+	// The whole ring counts as zero-dimensional, and the zero ideal does not.
+	bool isZeroDimensional() const;
+
+	// Returns true if every element of the basis is homogeneous: all its terms have the same
+	// total degree. Then so is the ideal.
+	bool isHomogeneous() const;
+
+	// Returns the Hilbert series of the ideal of the leading powers of the basis, in the given
+	// number of variables or the number present, whichever is greater. For a homogeneous ideal
+	// this is the Hilbert series of the ideal itself, whatever the term order.
+	HilbertSeries hilbertSeries(size_t variables = 0) const { return HilbertSeries(mLeading.begin(), mLeading.end(), variables); }
+
+	// Sets the Hilbert series the ideal is expected to have, or null (the default) for none,
+	// such as one computed modulo a prime or in another term order. While the generators are
+	// homogeneous, computing the basis then takes the critical pairs a degree at a time, and
+	// skips the rest of a degree once it has as many leading powers as the series implies:
+	// their S-polynomials would all reduce to zero. The series must be right: one that implies
+	// too few leading powers in some degree gives a basis that is not a Grobner basis, unless
+	// the computation notices and throws std::logic_error. One that implies too many only
+	// skips fewer pairs.
+	// The basis is not recomputed.
+	void setHilbertSeries(std::shared_ptr<const HilbertSeries> series) { pHilbert = std::move(series); }
+
+	// Returns the expected Hilbert series, or null if there is none.
+	const std::shared_ptr<const HilbertSeries>& expectedHilbertSeries() const { return pHilbert; }
+
+	// Returns the term order.
+	const PowerProduct::TermOrder& termOrder() const { return *pTermOrder; }
+
+	// Measurements of the work done computing Grobner bases.
+	struct Statistics
+	{
+		size_t pairsCreated{ 0 }; // critical pairs formed by Buchberger's algorithm
+		size_t pairsPruned{ 0 }; // of those, the ones discarded unreduced by Buchberger's first criterion
+		size_t pairsSkipped{ 0 }; // of those, the ones discarded unreduced as the Hilbert series completed their degree
+		size_t pairsReduced{ 0 }; // S-polynomials of critical pairs reduced
+		size_t zeroReductions{ 0 }; // of those, the ones that reduced to zero
+		size_t reductionSteps{ 0 }; // leading terms cancelled, computing and reducing bases
+		size_t maxBasisSize{ 0 }; // the most elements in a basis, generators included
+		size_t maxTerms{ 0 }; // the most terms in a basis element
+		int maxCoefficientBits{ 0 }; // the most bits in a coefficient of a basis element (see below)
+		double computeSeconds{ 0 }; // in Buchberger's algorithm
+		double minimizeSeconds{ 0 }; // discarding redundant elements
+		double reduceSeconds{ 0 }; // reducing the tails of the elements
+	};
+
+	// Returns the work done computing Grobner bases while statistics were enabled, since
+	// construction or resetStatistics. Bases converted to a new term order by FGLM or the
+	// walk, or found in the cache, add nothing. The bits of a rational coefficient are those
+	// of the larger of its numerator and denominator; other types count their precision.
+	const Statistics& statistics() const { return mStatistics; }
+
+	// Starts or stops collecting statistics (off by default). Collecting costs a few clock
+	// readings per basis and a pass over each new basis element.
+	void setStatisticsEnabled(bool enabled) { mCollectStatistics = enabled; }
+
+	// Returns true if statistics are being collected.
+	bool statisticsEnabled() const { return mCollectStatistics; }
+
+	// Sets the counts in statistics() to zero, and the peaks in memory() to the memory in use.
+	void resetStatistics()
+	{
+		mStatistics = Statistics();
+		pMemory->resetPeaks();
+	}
+
+	// Returns the memory used computing Grobner bases, by category: the terms of the basis, the
+	// critical pairs, and the terms of the polynomials computed along the way. It is counted
+	// while memory counting is enabled, a memory limit is set, or the budget limits memory.
+	// Bases converted by FGLM, or read from a file or the cache, are not counted.
+	const MemoryAccount& memory() const { return *pMemory; }
+
+	// Starts or stops counting memory() without a limit (off by default). Counting costs a
+	// few additions per allocation, and a copy of each new basis element.
+	void setMemoryCountingEnabled(bool enabled) { mCountMemory = enabled; }
+
+	// Returns true if memory is counted without a limit.
+	bool memoryCountingEnabled() const { return mCountMemory; }
+
+	// Sets a soft limit, in bytes, on the memory counted by memory(); 0 (the default) for none.
+	// A computation that would go over it throws MemoryAccount::LimitException, a std::bad_alloc.
+	void setMemoryLimit(size_t bytes) { pMemory->setLimit(bytes); }
+
+	// Sets the tracer that records computing Grobner bases as timed spans: the batches of
+	// pairs selected, each S-polynomial and its reduction, each basis element inserted,
+	// minimization, interreduction, and each call of reduce. Null (the default) for none.
+	// Several ideals may share a tracer.
+	void setTracer(std::shared_ptr<Tracer> tracer) { pTracer = std::move(tracer); }
+
+	// Returns the tracer, or null if there is none.
+	const std::shared_ptr<Tracer>& tracer() const { return pTracer; }
+
+	// Sets the budget that computing Grobner bases, converting them to a new term order, and
+	// reducing and testing polynomials are checked against; null (the default) for none. The
+	// pairs and basis size are counted afresh by each computation of a basis. When the budget
+	// runs out, the call throws Budget::ExceededException and the basis is left as it was
+	// before the call. Another thread may cancel the budget to stop a computation.
+	void setBudget(std::shared_ptr<Budget> budget) { pBudget = std::move(budget); }
+
+	// Returns the budget, or null if there is none.
+	const std::shared_ptr<Budget>& budget() const { return pBudget; }
+
+	// Sets the progress that computing and converting Grobner bases report to, so another
+	// thread can follow them; null (the default) for none.
+	void setProgress(std::shared_ptr<Progress> progress) { pProgress = std::move(progress); }
+
+	// Returns the progress, or null if there is none.
+	const std::shared_ptr<Progress>& progress() const { return pProgress; }
+
+	// Writes the reduced Grobner basis and term order to out in the binary format (see
+	// BinaryFormat), with the given variable names. Throws std::logic_error if the term order
+	// has no matrix description (see TermOrder::matrix).
+	void write(std::ostream& out, const std::vector<std::string>& variableNames = {}) const;
+
+	// Replaces the basis and term order with the next ones read by reader, written by write.
+	// The basis is used as it is, without recomputing it; the term order becomes a
+	// MatrixTermOrder. The thread count and cache are kept.
+	void read(BinaryReader<CoefT>& reader);
+
+	// Iterators over the reduced Grobner basis, greatest leading power first.
+	auto begin() const { return mGrobner.cbegin(); }
+	auto end() const { return mGrobner.cend(); }
+
 	// Prints the Grobner basis of this ideal using a Printer.
 	std::string toString(Printer<CoefT>& printer);
 
+	// Writes the Grobner basis of this ideal directly to out using a Printer, as toString
+	// would return it.
+	void print(std::ostream& out, Printer<CoefT>& printer) const;
+
 private:
 	using P = Polynomial<CoefT>;
-	using Basis = std::list<P>; //linked list for simple insertion/deletion
+	using Basis = std::vector<P>; //kept sorted by leading power, greatest first, once reduced
 
 	// The Grobner basis of this ideal.
 	Basis mGrobner;
 
-	// The term order to use
-	std::unique_ptr<const PowerProduct::TermOrder> pTermOrder;
+	// The leading power of each element of mGrobner, so reduction need not search for it.
+	std::vector<PowerProduct> mLeading;
 
-	//Compute the grobner basis using Buchberger's algorithm.
-	void computeGrobnerBasis();
+	// The least total degree in mLeading (0 for the zero ideal).
+	int mMinLeadingDegree{ 0 };
+
+	// The variables present in each power of mLeading (see support).
+	std::vector<std::uint64_t> mSupports;
+
+	// True if mGrobner is the reduced Grobner basis with respect to pTermOrder.
+	bool mReduced{ false };
+
+	// The term order to use; shared by copies
+	std::shared_ptr<const PowerProduct::TermOrder> pTermOrder;
+
+	// The workers for parallel computation, or null to compute serially.
+	std::shared_ptr<ThreadPool> pPool;
+
+	// The cache of reduced bases, or null for none.
+	std::shared_ptr<const BasisCache> pCache;
+
+	// The work done so far.
+	Statistics mStatistics;
+
+	// True if mStatistics is being updated.
+	bool mCollectStatistics{ false };
+
+	// The tracer to record spans with, or null for none.
+	std::shared_ptr<Tracer> pTracer;
+
+	// The memory counted for the computations; the basis may be charged to it.
+	std::shared_ptr<MemoryAccount> pMemory{ std::make_shared<MemoryAccount>() };
+
+	// True if memory is counted even without a limit.
+	bool mCountMemory{ false };
+
+	// The limits on computations, or null for none.
+	std::shared_ptr<Budget> pBudget;
+
+	// Where computations report their progress, or null for none.
+	std::shared_ptr<Progress> pProgress;
+
+	// The Hilbert series the ideal is expected to have, or null for none.
+	std::shared_ptr<const HilbertSeries> pHilbert;
+
+	//The number of S-polynomials reduced together by each step of a parallel computation,
+	//per thread. Larger batches keep the threads busier, but may reduce more pairs that a
+	//basis element found earlier in the batch would have made redundant.
+	static constexpr size_t batchPerThread = 4;
+
+	//Compute the grobner basis using Buchberger's algorithm. If given, stop is called
+	//before the first pair and after each new basis element; returning true abandons the
+	//computation, leaving a partial basis of the same ideal. Returns false if abandoned.
+	//The elements before firstNew must already be a Grobner basis, so no pair of them is reduced.
+	//If expected is given and the generators are homogeneous, the computation is driven by
+	//that Hilbert series (see setHilbertSeries).
+	bool computeGrobnerBasis(const std::function<bool()>& stop = nullptr, size_t firstNew = 0,
+		const HilbertSeries* expected = nullptr);
+
+	//Replace the generators in mGrobner by the reduced Grobner basis, from the cache if it
+	//is there, driven by the expected Hilbert series if given.
+	void computeReducedGrobnerBasis(const HilbertSeries* expected);
+
+	//Describe the generators in mGrobner, the term order, and the coefficient type in a form
+	//that does not depend on the order or scaling of the generators, to key the cache.
+	//Returns an empty string if the term order cannot be described.
+	std::string cacheDescription() const;
+
+	//Write the polynomials of the basis, or read them back, in the binary format.
+	//readBasis throws BinaryFormat::FormatException if they are not a basis.
+	void writeBasis(BinaryWriter<CoefT>& writer) const;
+	static Basis readBasis(BinaryReader<CoefT>& reader);
 
 	//Discard redundant terms, creating a minimal Grobner basis.
 	void minimizeGrobnerBasis();
 
-	//Compute the reduced Grobner basis from the minimal one.
-	void reduceGrobnerBasis();
+	//Compute the reduced Grobner basis from the minimal one. If added is given, the basis
+	//was reduced before the elements with those leading powers were added, so only those
+	//elements and the ones with a tail term divisible by one of them need reducing.
+	void reduceGrobnerBasis(const std::vector<PowerProduct>* added = nullptr);
 
 	//Compute the S-polynomial of f and g used in Buchberger's algorithm.
 	P sPoly(const P& f, const P& g);
+
+	//Reduce p, adding the number of leading terms cancelled to *steps if steps is given.
+	P reduce(P p, size_t* steps) const;
+
+	//Cancel leading terms of p until its leading term is not divisible by any in the basis.
+	//Unlike reduce, the lower terms are left alone. Adds the number cancelled to *steps if given.
+	P topReduce(P p, size_t* steps = nullptr) const;
+
+	//Call f, adding the seconds it takes to seconds if statistics are being collected.
+	template <typename Function>
+	void timed(double& seconds, Function f);
+
+	//Returns the account to charge memory to, or null if it is not being counted.
+	MemoryAccount* activeAccount() const
+	{
+		return mCountMemory || pMemory->limit() != 0 || (pBudget && pBudget->maxMemory() != 0)
+			? pMemory.get() : nullptr;
+	}
+
+	//Report the start of phase to the progress, if any.
+	void setPhase(Progress::Phase phase) const
+	{
+		if (pProgress)
+			pProgress->setPhase(phase);
+	}
+
+	//Throw Budget::ExceededException if the budget, if any, is cancelled or out of time.
+	void checkBudget() const
+	{
+		if (pBudget)
+			pBudget->check();
+	}
+
+	//Start a span of the tracer, which records nothing if there is none.
+	Tracer::Span trace(const char* name) const { return Tracer::Span(pTracer.get(), name); }
+
+	//Update the greatest sizes in mStatistics for p, an element of the basis.
+	void recordElement(const P& p);
+
+	//The bits in a coefficient, as counted by Statistics.
+	template <typename T>
+	static int coefficientBits(const T&) { return std::numeric_limits<T>::digits; }
+	template <typename Integer>
+	static int coefficientBits(const Rational<Integer>& c);
+
+	//Convert the reduced basis to the reduced basis with respect to newOrder by the FGLM
+	//algorithm. The ideal must be zero-dimensional.
+	Basis convertByFGLM(const PowerProduct::TermOrder& newOrder) const;
+
+	//True if the basis can be converted to newOrder by the Grobner walk: both orders are
+	//described by matrices.
+	bool canWalkTo(const PowerProduct::TermOrder& newOrder) const;
+
+	//Convert the reduced basis to the reduced basis with respect to newOrder by the
+	//Grobner walk. canWalkTo(newOrder) must be true.
+	Basis convertByWalk(const PowerProduct::TermOrder& newOrder) const;
+
+	//Divide f by divisors with respect to order, returning the quotients: f is the sum of
+	//quotients[k] * divisors[k], plus a remainder.
+	static std::vector<P> divide(P f, const Basis& divisors, const PowerProduct::TermOrder& order);
+
+	//Returns the number of variables present in the basis.
+	size_t variables() const;
+
+	//Recompute mLeading, mMinLeadingDegree and mSupports from mGrobner.
+	void updateLeading();
+
+	//A bit for each variable present in power, the last shared by the variables past it, so
+	//a power divides another only if its bits are a subset of the other's.
+	static std::uint64_t support(const PowerProduct& power)
+	{
+		std::uint64_t bits = 0;
+		for (size_t n = 0; n < power.variables(); ++n)
+			if (power.degree(n) != 0)
+				bits |= std::uint64_t(1) << std::min<size_t>(n, 63);
+		return bits;
+	}
+
+	//Call f(i) for each i in [0,count), on the thread pool if there is one.
+	template <typename Function>
+	void forEach(size_t count, Function f) const;
 };
 
 template <class CoefT>
-Polynomial<CoefT> Ideal<CoefT>::reduce(Polynomial<CoefT> p) const
+template <typename PolyIterator>
+void Ideal<CoefT>::addGenerators(PolyIterator first, PolyIterator last)
+{
+	//members of the ideal add nothing; the others are appended as their remainders, which
+	//have leading powers the basis cannot divide
+	Basis remainders;
+	reduceAll(first, last, std::back_inserter(remainders));
+	if (std::all_of(remainders.begin(), remainders.end(), [](const P& r) { return r == 0; }))
+		return;
+	Basis previous = mGrobner; //restored if the computation fails
+	size_t firstNew = mGrobner.size();
+	for (P& r : remainders)
+		if (r != 0)
+			mGrobner.push_back(std::move(r));
+
+	std::vector<PowerProduct> oldLeading = mLeading;
+	try
+	{
+		timed(mStatistics.computeSeconds, [&]() { computeGrobnerBasis(nullptr, firstNew, pHilbert.get()); });
+		timed(mStatistics.minimizeSeconds, [&]() { minimizeGrobnerBasis(); });
+
+		//the old leading powers that survived minimization still head fully reduced elements
+		std::vector<PowerProduct> added;
+		for (const PowerProduct& leading : mLeading)
+			if (std::find(oldLeading.begin(), oldLeading.end(), leading) == oldLeading.end())
+				added.push_back(leading);
+		timed(mStatistics.reduceSeconds, [&]() { reduceGrobnerBasis(&added); });
+	}
+	catch (...)
+	{
+		mGrobner = std::move(previous);
+		updateLeading();
+		throw;
+	}
+	mReduced = true; //the zero ideal's empty basis may not have been marked
+}
+
+template <class CoefT>
+Polynomial<CoefT> Ideal<CoefT>::reduce(Polynomial<CoefT> p, size_t* steps) const
 {
 	//multivariate division algorithm; see companion paper for a prose description
+	NodePool::Scope pool;
+	Tracer::Span span = trace("reduce");
+	span.arg("terms", p.size());
+	size_t taken = 0;
+	size_t* counter = steps || span ? &taken : nullptr;
 	P remainder{};
-	auto dividesLeadingTerm = [&](P f) 
+	while ((p = topReduce(std::move(p), counter)) != 0) //cancel leading terms while possible
 	{
-		return p.leadingPower(*pTermOrder).isDivisibleBy(f.leadingPower(*pTermOrder)); 
-	};
+		P leadingTerm = p.leadingTerm(*pTermOrder);
+		remainder += leadingTerm; //the leading term is irreducible, so it belongs to the remainder
+		p -= leadingTerm;
+	}
+
+	if (steps)
+		*steps += taken;
+	span.arg("steps", taken).arg("remainderTerms", remainder.size());
+	return remainder;
+}
 
+template <class CoefT>
+Polynomial<CoefT> Ideal<CoefT>::topReduce(Polynomial<CoefT> p, size_t* steps) const
+{
 	while (p != 0)
 	{
+		checkBudget();
 		//look for a basis element that divides the leading term of p
-		auto match = std::find_if(mGrobner.begin(), mGrobner.end(), dividesLeadingTerm);
-		if (match != mGrobner.end()) //if one was found
-			p -= (p.leadingTerm(*pTermOrder) / match->leadingTerm(*pTermOrder)) * *match; //cancel the leading term
-		else
-		{
-			remainder += p.leadingTerm(*pTermOrder); //add the leading term to the remainder
-			p -= p.leadingTerm(*pTermOrder);
-		}
+		P leadingTerm = p.leadingTerm(*pTermOrder);
+		PowerProduct leadingPower = p.leadingPower(*pTermOrder);
+		auto match = std::find_if(mLeading.begin(), mLeading.end(),
+			[&](const PowerProduct& divisor) { return leadingPower.isDivisibleBy(divisor); });
+		if (match == mLeading.end()) //the leading term is irreducible
+			break;
+		const P& divisor = mGrobner[match - mLeading.begin()];
+		p -= (leadingTerm / divisor.leadingTerm(*pTermOrder)) * divisor; //cancel the leading term
+		if (steps)
+			++*steps;
 	}
 
-	return remainder;
+	return p;
+}
+
+template <class CoefT>
+bool Ideal<CoefT>::isMember(Polynomial<CoefT> p) const
+{
+	if (p == 0)
+		return true;
+	if (mGrobner.empty()) //the zero ideal
+		return false;
+	if (mMinLeadingDegree == 0) //a constant in the basis: the whole ring
+		return true;
+	PowerProduct leading = p.leadingPower(*pTermOrder);
+	if (leading.degree() < mMinLeadingDegree)
+		return false; //no leading power in the basis can divide the leading power of p
+	std::uint64_t variables = support(leading);
+	if (std::none_of(mSupports.begin(), mSupports.end(), [&](std::uint64_t s) { return (s & ~variables) == 0; }))
+		return false; //nor can any with a variable the leading power of p lacks
+
+	//p reduces to zero exactly when its leading term can be cancelled at every step; the
+	//first irreducible leading term would be part of a nonzero remainder
+	NodePool::Scope pool;
+	return topReduce(std::move(p)) == 0;
+}
+
+template <class CoefT>
+template <typename PolyIterator>
+bool Ideal<CoefT>::isMemberOf(PolyIterator first, PolyIterator last, const Polynomial<CoefT>& p,
+	std::unique_ptr<PowerProduct::TermOrder> termOrder)
+{
+	if (!termOrder)
+		throw std::logic_error("null term order");
+	Ideal partial;
+	partial.pTermOrder = std::move(termOrder);
+	for (auto it = first; it != last; ++it)
+		if (*it != 0)
+			partial.mGrobner.push_back(*it);
+
+	//target stays congruent to p modulo the partial basis, which generates a subideal,
+	//so reducing it to zero proves membership; each test picks up where the last left off
+	P target = p;
+	auto reducesToZero = [&]()
+	{
+		target = partial.topReduce(std::move(target));
+		return target == 0;
+	};
+	if (!partial.computeGrobnerBasis(reducesToZero))
+		return true;
+
+	//the basis is complete, and target has already been top-reduced by all of it
+	return target == 0;
+}
+
+template <class CoefT>
+template <typename PolyIterator, typename OutputIterator>
+OutputIterator Ideal<CoefT>::reduceAll(PolyIterator first, PolyIterator last, OutputIterator out) const
+{
+	std::vector<P> polys(first, last); //random access for the workers; reduced in place
+	forEach(polys.size(), [&](size_t i) { polys[i] = reduce(std::move(polys[i])); });
+	return std::move(polys.begin(), polys.end(), out);
+}
+
+template <class CoefT>
+template <typename PolyIterator, typename OutputIterator>
+OutputIterator Ideal<CoefT>::isMemberAll(PolyIterator first, PolyIterator last, OutputIterator out) const
+{
+	std::vector<const P*> polys;
+	for (auto it = first; it != last; ++it)
+		polys.push_back(&*it);
+	std::vector<char> members(polys.size()); //not vector<bool>, whose elements share bytes
+	forEach(polys.size(), [&](size_t i) { members[i] = isMember(*polys[i]); });
+	return std::copy(members.begin(), members.end(), out);
 }
 
 template<class CoefT>
 std::string Ideal<CoefT>::toString(Printer<CoefT>& printer)
 {
-	//format: ( x^2 + 1, y*z )
 	std::ostringstream ss;
-	ss << "( ";
+	print(ss, printer);
+	return ss.str();
+}
+
+template<class CoefT>
+void Ideal<CoefT>::print(std::ostream& out, Printer<CoefT>& printer) const
+{
+	//format: ( x^2 + 1, y*z )
+	out << "( ";
 	for (auto it = mGrobner.begin(); it != mGrobner.end(); ++it)
 	{
 		if (it != mGrobner.begin())
-			ss << " , ";
-		ss << it->toString(printer,*pTermOrder);
+			out << " , ";
+		it->print(out, printer, *pTermOrder);
 	}
-	ss << " )";
-	return ss.str();
+	out << " )";
 }
 
 template<class CoefT>
-void Ideal<CoefT>::computeGrobnerBasis()
+bool Ideal<CoefT>::computeGrobnerBasis(const std::function<bool()>& stop, size_t firstNew,
+	const HilbertSeries* expected)
 {
 	//Buchberger's algorithm; see companion paper for explanation
-	std::queue<std::pair<P, P>> pairs; //pairs of elements of the current basis
-	for (auto second = mGrobner.begin(); second != mGrobner.end(); ++second)
-		for (auto first = mGrobner.begin(); first != second; ++first)
-			pairs.push({ *first,*second });
+	Tracer::Span span = trace("compute basis");
+	span.arg("generators", mGrobner.size()).arg("firstNew", firstNew);
+	setPhase(Progress::Computing);
+	updateLeading();
+	if (stop && stop())
+		return false;
+	checkBudget();
+	bool collect = mCollectStatistics;
+	if (collect)
+		for (const P& g : mGrobner)
+			recordElement(g);
+
+	//new polynomials are temporaries until they join the basis, which is copied to charge it
+	//to the basis; the copies are linear in the terms, and happen only while counting
+	MemoryAccount* account = activeAccount();
+	MemoryAccount::Scope scope(account, MemoryAccount::Temporaries);
+	NodePool::Scope pool;
+	if (account)
+	{
+		MemoryAccount::Scope basisScope(account, MemoryAccount::Basis);
+		for (P& g : mGrobner)
+			g = P(g);
+	}
+
+	//Hilbert-driven: the pairs are taken in order of the degree of their least common multiple,
+	//which for homogeneous generators is that of their S-polynomial. Once the pairs of lesser
+	//degrees are done, the basis has every leading power of its degree but those the pairs
+	//of that degree would add, so when the Hilbert function of the leading powers reaches the
+	//expected one there, those pairs would add none.
+	if (expected && !isHomogeneous())
+		expected = nullptr;
+	using Pair = std::pair<size_t, size_t>; //indices into the current basis
+	auto pairDegree = [&](const Pair& pair)
+	{
+		const PowerProduct& first = mLeading[pair.first];
+		const PowerProduct& second = mLeading[pair.second];
+		int degree = 0;
+		for (size_t n = 0; n < std::max(first.variables(), second.variables()); ++n)
+			degree += std::max(first.degree(n), second.degree(n));
+		return degree;
+	};
+
+	//The pairs queued, in the order they were formed, in buckets by degree when driven by the
+	//Hilbert series and otherwise all in bucket 0; the lowest bucket is taken from first.
+	//Empty buckets are removed.
+	using Queue = std::deque<Pair, CountingAllocator<Pair>>;
+	using Buckets = std::map<int, Queue, std::less<int>, CountingAllocator<std::pair<const int, Queue>>>;
+	CountingAllocator<Pair> pairAllocator(account, MemoryAccount::Pairs);
+	Buckets pairs(pairAllocator);
+	size_t queued = 0;
+
+	//Buchberger's first criterion: the S-polynomial of elements whose leading powers are
+	//coprime always reduces to zero, so such pairs are dropped as soon as they are formed
+	auto addPair = [&](size_t first, size_t second)
+	{
+		bool pruned = mLeading[first].isCoprimeTo(mLeading[second]);
+		if (!pruned)
+		{
+			Pair pair{ first, second };
+			pairs.try_emplace(expected ? pairDegree(pair) : 0, pairAllocator).first->second.push_back(pair);
+			++queued;
+		}
+		if (collect)
+		{
+			++mStatistics.pairsCreated;
+			mStatistics.pairsPruned += pruned;
+		}
+	};
+	for (size_t second = firstNew; second < mGrobner.size(); ++second)
+		for (size_t first = 0; first < second; ++first)
+			addPair(first, second);
+
+	//With a thread pool, a batch of pairs is reduced at once against the basis as it stood
+	//when the batch was taken. The results are then merged in order, each top-reduced again
+	//by whatever the batch has added so far, so the outcome does not depend on timing.
+	size_t batchSize = pPool ? pPool->size() * batchPerThread : 1;
+	std::vector<Pair> batch;
+	std::vector<P> reduced;
+	std::vector<size_t> steps; //reduction steps of each S-polynomial, while collecting or tracing
+	size_t* mergeSteps = collect ? &mStatistics.reductionSteps : nullptr;
+	size_t pairsTaken = 0; //for the budget
+	auto spend = [&]() //and report progress
+	{
+		if (pProgress)
+			pProgress->update(queued, pairsTaken, mGrobner.size());
+		if (pBudget)
+			pBudget->check(pairsTaken, mGrobner.size(), account ? account->current() : 0);
+	};
+
+	size_t checkedSize = 0; //the basis size and degree found incomplete last, so not checked again
+	int checkedDegree = -1;
+	auto degreeComplete = [&](int degree)
+	{
+		if (mGrobner.size() == checkedSize && degree == checkedDegree)
+			return false;
+		checkedSize = mGrobner.size();
+		checkedDegree = degree;
+		Tracer::Span hilbertSpan = trace("Hilbert function");
+		std::vector<PowerProduct> lower; //greater leading powers leave this degree alone
+		for (const PowerProduct& leading : mLeading)
+			if (leading.degree() <= degree)
+				lower.push_back(leading);
+		HilbertSeries found(std::move(lower), expected->variables());
+		long long have = found.function(degree), want = expected->function(degree);
+		hilbertSpan.arg("degree", degree).arg("found", have).arg("expected", want);
+		if (found.variables() != expected->variables() || have < want)
+			throw std::logic_error("the ideal does not have the expected Hilbert series");
+		return have == want;
+	};
+
 	while (!pairs.empty())
 	{
-		auto pair = pairs.front();
-		pairs.pop();
-		P h = reduce(sPoly(pair.first, pair.second)); 
-		if (h != 0)
+		auto lowest = pairs.begin();
+		Queue& queue = lowest->second;
+		if (expected && degreeComplete(lowest->first))
+		{
+			if (collect)
+				mStatistics.pairsSkipped += queue.size();
+			queued -= queue.size();
+			pairs.erase(lowest);
+			continue;
+		}
+		size_t count = std::min(batchSize, queue.size());
 		{
-			for (const auto& g : mGrobner)
-				pairs.push({ g,h });
-			mGrobner.push_back(h);
+			Tracer::Span selectSpan = trace("select pairs");
+			batch.assign(queue.begin(), queue.begin() + count);
+			queue.erase(queue.begin(), queue.begin() + count);
+			if (queue.empty())
+				pairs.erase(lowest);
+			queued -= count;
+			selectSpan.arg("pairs", count).arg("queued", queued).arg("basis", mGrobner.size());
+		}
+		pairsTaken += count;
+		spend();
+		reduced.assign(count, P());
+		steps.assign(collect || pTracer ? count : 0, 0);
+		forEach(count, [&](size_t i)
+		{
+			MemoryAccount::Scope workerScope(account, MemoryAccount::Temporaries);
+			NodePool::Scope workerPool; //on a pool thread, released with the reduction
+			auto [first, second] = batch[i];
+			P s;
+			{
+				Tracer::Span sSpan = trace("S-polynomial");
+				s = sPoly(mGrobner[first], mGrobner[second]);
+				if (sSpan)
+					sSpan.arg("first", first).arg("second", second)
+						.arg("degree", mLeading[first].lcm(mLeading[second]).degree()).arg("terms", s.size());
+			}
+			//tails are reduced once, at the end
+			Tracer::Span reduceSpan = trace("top-reduce");
+			reduceSpan.arg("terms", s.size());
+			reduced[i] = topReduce(std::move(s), steps.empty() ? nullptr : &steps[i]);
+			if (reduceSpan)
+				reduceSpan.arg("steps", steps[i]).arg("zero", reduced[i] == 0).arg("resultTerms", reduced[i].size());
+		});
+		if (collect)
+		{
+			mStatistics.pairsReduced += count;
+			for (size_t s : steps)
+				mStatistics.reductionSteps += s;
+		}
+
+		for (P& h : reduced)
+		{
+			if (h != 0 && count > 1)
+				h = topReduce(std::move(h), mergeSteps); //the basis may have grown since h was reduced
+			if (h == 0)
+			{
+				if (collect)
+					++mStatistics.zeroReductions;
+			}
+			else
+			{
+				Tracer::Span insertSpan = trace("insert");
+				if (account)
+				{
+					MemoryAccount::Scope basisScope(account, MemoryAccount::Basis);
+					h = P(h);
+				}
+				size_t index = mGrobner.size(), before = queued;
+				mLeading.push_back(h.leadingPower(*pTermOrder));
+				mMinLeadingDegree = std::min(mMinLeadingDegree, mLeading.back().degree());
+				mSupports.push_back(support(mLeading.back()));
+				mGrobner.push_back(std::move(h));
+				for (size_t g = 0; g < index; ++g)
+					addPair(g, index);
+				insertSpan.arg("index", index).arg("degree", mLeading.back().degree())
+					.arg("terms", mGrobner.back().size()).arg("pairs", queued - before);
+				if (collect)
+					recordElement(mGrobner.back());
+				spend();
+				if (stop && stop())
+					return false;
+			}
 		}
 	}
+	return true;
 }
 
 template<class CoefT>
-void Ideal<CoefT>::minimizeGrobnerBasis()
+void Ideal<CoefT>::computeReducedGrobnerBasis(const HilbertSeries* expected)
 {
-	for (auto it1 = mGrobner.begin(); it1 != mGrobner.end(); ++it1)
-		for (auto it2 = mGrobner.begin(); it2 != mGrobner.end(); )
+	std::string description = pCache ? cacheDescription() : std::string();
+	if (!description.empty())
+	{
+		auto cached = pCache->load(description);
+		if (cached)
 		{
-			//delete redundant elements
-			if (it1 != it2 && it1->leadingPower(*pTermOrder).isDivisibleBy(it2->leadingPower(*pTermOrder)))
+			try
 			{
-				it1 = mGrobner.erase(it1); 
-				it2 = mGrobner.begin();
+				BinaryReader<CoefT> reader(cached->data(), cached->size());
+				mGrobner = readBasis(reader);
+				updateLeading();
+				return;
 			}
-			else
-				++it2;
+			catch (BinaryFormat::FormatException&) {} //damaged; compute it again
 		}
+	}
+
+	timed(mStatistics.computeSeconds, [&]() { computeGrobnerBasis(nullptr, 0, expected); });
+	timed(mStatistics.minimizeSeconds, [&]() { minimizeGrobnerBasis(); });
+	timed(mStatistics.reduceSeconds, [&]() { reduceGrobnerBasis(); });
+
+	if (!description.empty())
+	{
+		std::ostringstream contents;
+		BinaryWriter<CoefT> writer(contents, {}); //the description holds the rest of the header
+		writeBasis(writer);
+		pCache->store(description, contents.str());
+	}
+}
+
+template<class CoefT>
+std::string Ideal<CoefT>::cacheDescription() const
+{
+	size_t variables = this->variables();
+	PowerProduct::TermOrder::Matrix matrix = pTermOrder->matrix(variables);
+	if (matrix.empty() && variables > 0)
+		return std::string();
+
+	//each generator made monic, and the set of them sorted, so the same ideal written
+	//differently still matches
+	std::vector<std::string> generators;
+	for (const P& g : mGrobner)
+	{
+		std::ostringstream ss;
+		ss.precision(std::numeric_limits<CoefT>::max_digits10);
+		CoefT leadingCoef = g.leadingCoef(*pTermOrder);
+		for (const auto& term : g)
+		{
+			ss << term.second / leadingCoef;
+			for (size_t n = 0; n < term.first.variables(); ++n)
+				ss << ' ' << term.first.degree(n);
+			ss << ';';
+		}
+		generators.push_back(ss.str());
+	}
+	std::sort(generators.begin(), generators.end());
+	generators.erase(std::unique(generators.begin(), generators.end()), generators.end());
+
+	std::ostringstream description;
+	description << CoefficientCodec<CoefT>::name() << '\n' << variables << '\n';
+	for (const auto& row : matrix)
+	{
+		for (long long weight : row)
+			description << weight << ' ';
+		description << '\n';
+	}
+	for (const auto& g : generators)
+		description << g << '\n';
+	return description.str();
+}
+
+template<class CoefT>
+void Ideal<CoefT>::write(std::ostream& out, const std::vector<std::string>& variableNames) const
+{
+	size_t variables = std::max(this->variables(), variableNames.size());
+	BinaryFormat::Header header{ variableNames, pTermOrder->matrix(variables), {} };
+	if (header.termOrder.empty() && variables > 0)
+		throw std::logic_error("term order has no matrix description");
+	BinaryWriter<CoefT> writer(out, std::move(header));
+	writeBasis(writer);
+}
+
+template<class CoefT>
+void Ideal<CoefT>::read(BinaryReader<CoefT>& reader)
+{
+	//read everything before changing anything, so a damaged file leaves the ideal as it was
+	std::unique_ptr<const PowerProduct::TermOrder> termOrder;
+	try
+	{
+		termOrder = std::make_unique<MatrixTermOrder>(reader.header().termOrder);
+	}
+	catch (std::logic_error&)
+	{
+		throw BinaryFormat::FormatException("invalid term order");
+	}
+	Basis basis = readBasis(reader);
+
+	pTermOrder = std::move(termOrder);
+	mGrobner = std::move(basis);
+	updateLeading();
+	mReduced = true;
+}
+
+template<class CoefT>
+void Ideal<CoefT>::writeBasis(BinaryWriter<CoefT>& writer) const
+{
+	for (const P& g : mGrobner)
+		writer.write(g);
+	writer.finish();
+}
+
+template<class CoefT>
+typename Ideal<CoefT>::Basis Ideal<CoefT>::readBasis(BinaryReader<CoefT>& reader)
+{
+	Basis basis;
+	for (P p; reader.read(p);)
+	{
+		if (p == 0)
+			throw BinaryFormat::FormatException("zero basis element");
+		basis.push_back(std::move(p));
+	}
+	return basis;
+}
+
+template<class CoefT>
+void Ideal<CoefT>::minimizeGrobnerBasis()
+{
+	Tracer::Span span = trace("minimize");
+	span.arg("before", mGrobner.size());
+	setPhase(Progress::Minimizing);
+	checkBudget();
+	MemoryAccount::Scope scope(activeAccount(), MemoryAccount::Basis);
+
+	//sort by leading power, least first; a leading power can only be divisible by lesser ones
+	std::vector<std::pair<PowerProduct, P*>> byLeading;
 	for (P& p : mGrobner)
+		byLeading.push_back({ p.leadingPower(*pTermOrder), &p });
+	std::stable_sort(byLeading.begin(), byLeading.end(),
+		[&](const auto& l, const auto& r) { return (*pTermOrder)(l.first, r.first); });
+
+	//single pass: keep an element only if no kept element's leading power divides its own
+	std::vector<std::pair<PowerProduct, P*>> kept;
+	for (const auto& candidate : byLeading)
+	{
+		bool redundant = std::any_of(kept.begin(), kept.end(),
+			[&](const auto& k) { return candidate.first.isDivisibleBy(k.first); });
+		if (!redundant)
+			kept.push_back(candidate);
+	}
+
+	Basis minimal;
+	for (auto it = kept.rbegin(); it != kept.rend(); ++it) //greatest leading power first
+	{
+		P& p = *it->second;
 		p /= p.leadingCoef(*pTermOrder); //we want a monic basis
+		minimal.push_back(std::move(p));
+	}
+	mGrobner = std::move(minimal);
+	updateLeading();
+	span.arg("after", mGrobner.size());
 }
 
 template<class CoefT>
-void Ideal<CoefT>::reduceGrobnerBasis()
+void Ideal<CoefT>::reduceGrobnerBasis(const std::vector<PowerProduct>* added)
 {
-	for (auto it = mGrobner.begin(); it != mGrobner.end(); )
+	//In a minimal basis no leading term divides another, so reducing the tail of each
+	//element by the whole basis leaves the leading terms alone, and the elements can
+	//be reduced independently of one another.
+	Tracer::Span span = trace("interreduce");
+	span.arg("elements", mGrobner.size());
+	setPhase(Progress::Reducing);
+	MemoryAccount* account = activeAccount();
+	MemoryAccount::Scope scope(account, MemoryAccount::Basis);
+	Basis reduced(mGrobner.size());
+	bool collect = mCollectStatistics;
+	std::vector<size_t> steps(collect ? mGrobner.size() : 0);
+	forEach(mGrobner.size(), [&](size_t i)
+	{
+		MemoryAccount::Scope workerScope(account, MemoryAccount::Temporaries);
+		NodePool::Scope workerPool;
+		auto isAdded = [&](const PowerProduct& power)
+		{
+			return std::any_of(added->begin(), added->end(),
+				[&](const PowerProduct& a) { return power.isDivisibleBy(a); });
+		};
+		if (added && std::none_of(mGrobner[i].begin(), mGrobner[i].end(),
+			[&](const auto& term) { return isAdded(term.first); }))
+		{
+			reduced[i] = mGrobner[i]; //still reduced; copied, as the other reductions read it
+			return;
+		}
+		P leadingTerm = mGrobner[i].leadingTerm(*pTermOrder);
+		P tail = reduce(mGrobner[i] - leadingTerm, collect ? &steps[i] : nullptr);
+		MemoryAccount::Scope basisScope(account, MemoryAccount::Basis);
+		reduced[i] = leadingTerm + tail;
+	});
+	mGrobner = std::move(reduced);
+
+	if (collect)
 	{
-		auto g = *it;
-		it = mGrobner.erase(it);
-		mGrobner.insert(it, reduce(g)); //replace each element with its reduction by the others
+		for (size_t s : steps)
+			mStatistics.reductionSteps += s;
+		for (const P& g : mGrobner)
+			recordElement(g);
 	}
 }
 
@@ -205,3 +1140,381 @@ Polynomial<CoefT> Ideal<CoefT>::sPoly(const P& f, const P& g)
 	P lcm = f.leadingPower(*pTermOrder).lcm(g.leadingPower(*pTermOrder));
 	return (lcm / f.leadingTerm(*pTermOrder)) * f - (lcm / g.leadingTerm(*pTermOrder)) * g;
 }
+
+template<class CoefT>
+template<typename Function>
+void Ideal<CoefT>::timed(double& seconds, Function f)
+{
+	if (!mCollectStatistics)
+	{
+		f();
+		return;
+	}
+	auto start = std::chrono::steady_clock::now();
+	f();
+	seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<class CoefT>
+void Ideal<CoefT>::recordElement(const P& p)
+{
+	mStatistics.maxBasisSize = std::max(mStatistics.maxBasisSize, mGrobner.size());
+	mStatistics.maxTerms = std::max(mStatistics.maxTerms, p.size());
+	for (const auto& term : p)
+		mStatistics.maxCoefficientBits = std::max(mStatistics.maxCoefficientBits, coefficientBits(term.second));
+}
+
+template<class CoefT>
+template<typename Integer>
+int Ideal<CoefT>::coefficientBits(const Rational<Integer>& c)
+{
+	//the magnitudes as unsigned, so the most negative numerator has its true width
+	using Unsigned = std::make_unsigned_t<Integer>;
+	Unsigned numerator = c.numerator() < 0 ? Unsigned(0) - Unsigned(c.numerator()) : Unsigned(c.numerator());
+	Unsigned magnitude = std::max(numerator, Unsigned(c.denominator()));
+	int bits = 0;
+	for (; magnitude != 0; magnitude >>= 1)
+		++bits;
+	return bits;
+}
+
+template<class CoefT>
+bool Ideal<CoefT>::isHomogeneous() const
+{
+	return std::all_of(mGrobner.begin(), mGrobner.end(), [](const P& p)
+		{
+			return p == 0 || std::all_of(p.begin(), p.end(),
+				[&](const auto& term) { return term.first.degree() == p.begin()->first.degree(); });
+		});
+}
+
+template<class CoefT>
+bool Ideal<CoefT>::isZeroDimensional() const
+{
+	if (mGrobner.empty())
+		return false;
+
+	//look for a pure power of each variable among the leading powers
+	std::vector<bool> purePower(variables());
+	for (const PowerProduct& leading : mLeading)
+		if (leading.variables() > 0 && leading.degree() == leading.degree(leading.variables() - 1))
+			purePower[leading.variables() - 1] = true;
+	return std::all_of(purePower.begin(), purePower.end(), [](bool b) { return b; });
+}
+
+template<class CoefT>
+typename Ideal<CoefT>::Basis Ideal<CoefT>::convertByFGLM(const PowerProduct::TermOrder& newOrder) const
+{
+	//FGLM: the normal forms (remainders) with respect to the current basis form a finite-
+	//dimensional vector space. Walk through power products in increasing newOrder, keeping
+	//those whose normal forms are linearly independent of the ones before them. The first
+	//power product t whose normal form depends on them gives a new basis element: t minus
+	//that linear combination of lesser power products. Its multiples need not be visited.
+	//Every power product visited after 1 is x_n times a standard one s, so its normal form
+	//is that of x_n times the normal form of s: a combination of x_n times power products
+	//standard in the current order. Those normal forms are built up from the basis elements
+	//and kept, as the columns of the multiplication matrices, so nothing is reduced.
+	size_t variables = this->variables();
+
+	//the normal form of each power product met, with respect to the current basis
+	std::map<PowerProduct, P, std::reference_wrapper<const PowerProduct::TermOrder>> normalForms(*pTermOrder);
+	auto normalFormOf = [&](auto& self, const PowerProduct& u) -> const P&
+	{
+		auto found = normalForms.find(u);
+		if (found != normalForms.end())
+			return found->second;
+
+		P normalForm;
+		size_t k = 0;
+		while (k < mLeading.size() && !u.isDivisibleBy(mLeading[k]))
+			++k;
+		if (k == mLeading.size()) //standard
+			normalForm = u;
+		else if (u == mLeading[k]) //the tail of the reduced basis element, which is standard
+			normalForm = P(u) - mGrobner[k] / P(mGrobner[k].leadingCoef(*pTermOrder));
+		else
+		{
+			//u = x_n * v, where v is still divisible by the leading power, so every term of
+			//the normal form of v is less than v, and each x_n times it less than u
+			size_t n = 0;
+			while (u.degree(n) <= mLeading[k].degree(n))
+				++n;
+			const P& form = self(self, u / PowerProduct(n));
+			for (const auto& term : form)
+				normalForm += term.second * self(self, term.first * PowerProduct(n));
+		}
+		return normalForms.emplace(u, std::move(normalForm)).first->second;
+	};
+
+	//A row of the elimination: a normal form, scaled so its pivot coefficient is 1, and
+	//the polynomial (a combination of visited power products) it is the normal form of.
+	//Every pivot is zero in every other row.
+	struct Row
+	{
+		PowerProduct pivot;
+		P normalForm;
+		P preimage;
+	};
+	std::vector<Row> rows;
+	std::vector<P> standardForms; //the normal form of each row's standard power product
+
+	Basis converted;
+	std::vector<PowerProduct> leading; //leading powers of converted
+
+	//each candidate, with the row of the standard power product s and the variable x_n it is
+	//s * x_n of; 1 has none
+	constexpr size_t none = std::numeric_limits<size_t>::max();
+	std::map<PowerProduct, std::pair<size_t, size_t>, std::reference_wrapper<const PowerProduct::TermOrder>> candidates(newOrder);
+	candidates.emplace(PowerProduct(), std::make_pair(none, none));
+
+	while (!candidates.empty())
+	{
+		checkBudget();
+		PowerProduct t = candidates.begin()->first; //least remaining candidate
+		auto [from, variable] = candidates.begin()->second;
+		candidates.erase(candidates.begin());
+		if (std::any_of(leading.begin(), leading.end(), [&](const PowerProduct& l) { return t.isDivisibleBy(l); }))
+			continue; //a multiple of a leading power of the new basis
+
+		P form;
+		if (from == none)
+			form = normalFormOf(normalFormOf, t);
+		else
+			for (const auto& term : standardForms[from])
+				form += term.second * normalFormOf(normalFormOf, term.first * PowerProduct(variable));
+		P normalForm = form;
+		P preimage = t;
+		for (const Row& row : rows) //eliminate the pivots
+		{
+			CoefT c = normalForm.coefficient(row.pivot);
+			if (c != CoefT(0))
+			{
+				normalForm -= c * row.normalForm;
+				preimage -= c * row.preimage;
+			}
+		}
+
+		if (normalForm == 0) //t minus lesser power products is in the ideal
+		{
+			converted.push_back(preimage); //monic, with leading power t
+			leading.push_back(t);
+		}
+		else //t is a new standard power product
+		{
+			standardForms.push_back(std::move(form));
+			Row row{ normalForm.leadingPower(*pTermOrder), normalForm, preimage };
+			CoefT c = normalForm.coefficient(row.pivot);
+			row.normalForm /= c;
+			row.preimage /= c;
+			for (Row& other : rows) //keep the pivot zero in the other rows
+			{
+				CoefT d = other.normalForm.coefficient(row.pivot);
+				if (d != CoefT(0))
+				{
+					other.normalForm -= d * row.normalForm;
+					other.preimage -= d * row.preimage;
+				}
+			}
+			rows.push_back(std::move(row));
+
+			for (size_t n = 0; n < variables; ++n)
+				candidates.emplace(t * PowerProduct(n), std::make_pair(rows.size() - 1, n));
+		}
+	}
+
+	std::reverse(converted.begin(), converted.end()); //greatest leading power first
+	return converted;
+}
+
+template<class CoefT>
+bool Ideal<CoefT>::canWalkTo(const PowerProduct::TermOrder& newOrder) const
+{
+	size_t n = variables();
+	return n > 0 && !pTermOrder->matrix(n).empty() && !newOrder.matrix(n).empty();
+}
+
+template<class CoefT>
+typename Ideal<CoefT>::Basis Ideal<CoefT>::convertByWalk(const PowerProduct::TermOrder& newOrder) const
+{
+	//The Grobner walk (see Cox, Little & O'Shea, Using Algebraic Geometry, ch. 8): follow the
+	//segment from the first weight row of the current order to that of the target. At each
+	//weight w on it, where the basis is reduced with respect to the current order, the
+	//initial forms (terms of greatest w-weight) of the basis generate the initial ideal of w.
+	//A Grobner basis of that much smaller ideal with respect to w refined by the target order
+	//lifts to one of the whole ideal. Then move w up to the next cone boundary, where some
+	//element's leading term would change, and repeat until w reaches the target's weight.
+	using Matrix = PowerProduct::TermOrder::Matrix;
+	using Weight = std::vector<long long>;
+	size_t n = variables();
+	Matrix target = newOrder.matrix(n);
+	const Weight targetWeight = target.front();
+	Weight w = pTermOrder->matrix(n).front();
+
+	auto weight = [&](const Weight& weights, const PowerProduct& power)
+	{
+		long long sum = 0;
+		for (size_t i = 0; i < n; ++i)
+			sum += weights[i] * power.degree(i);
+		return sum;
+	};
+	auto initialForm = [&](const P& p)
+	{
+		long long top = std::numeric_limits<long long>::min();
+		for (const auto& term : p)
+			top = std::max(top, weight(w, term.first));
+		P form;
+		for (const auto& term : p)
+			if (weight(w, term.first) == top)
+				form += term.second * P(term.first);
+		return form;
+	};
+
+	Basis current = mGrobner;
+	std::shared_ptr<const PowerProduct::TermOrder> currentOrder = std::make_shared<MatrixTermOrder>(pTermOrder->matrix(n));
+	bool last = (w == targetWeight);
+	while (true)
+	{
+		Matrix refined{ w }; //w, ties broken by the target order
+		refined.insert(refined.end(), target.begin(), target.end());
+
+		//the reduced basis of the initial ideal with respect to the refined order
+		Basis initialForms;
+		for (const P& g : current)
+			initialForms.push_back(initialForm(g));
+		Ideal initial;
+		initial.pTermOrder = std::make_unique<MatrixTermOrder>(refined);
+		initial.pPool = pPool;
+		initial.pBudget = pBudget;
+		initial.pMemory = pMemory;
+		initial.mCountMemory = mCountMemory;
+		initial.setGenerators(initialForms.begin(), initialForms.end());
+
+		//lift it: dividing by the initial forms (a Grobner basis of the same initial ideal with
+		//respect to the current order) leaves no remainder, and the same combination of the
+		//basis elements themselves has the same initial form
+		Ideal lifted;
+		lifted.pTermOrder = std::make_unique<MatrixTermOrder>(refined);
+		lifted.pPool = pPool;
+		lifted.pBudget = pBudget;
+		lifted.pMemory = pMemory; //its basis is moved out, charged to the account
+		lifted.mCountMemory = mCountMemory;
+		lifted.mGrobner.resize(initial.mGrobner.size());
+		forEach(initial.mGrobner.size(), [&](size_t i)
+		{
+			std::vector<P> quotients = divide(initial.mGrobner[i], initialForms, *currentOrder);
+			for (size_t k = 0; k < quotients.size(); ++k)
+				if (quotients[k] != 0)
+					lifted.mGrobner[i] += quotients[k] * current[k];
+		});
+		lifted.minimizeGrobnerBasis();
+		lifted.reduceGrobnerBasis();
+		current = std::move(lifted.mGrobner);
+		currentOrder = std::move(lifted.pTermOrder);
+
+		if (last)
+			break;
+
+		//the next boundary: the least t in (0,1) where, for some element, the weight of a
+		//lesser term catches up with its leading term along (1-t)w + t*targetWeight
+		long long bestNum = 1, bestDen = 1; //t = 1: the target itself
+		for (const P& g : current)
+		{
+			PowerProduct leading = g.leadingPower(*currentOrder);
+			for (const auto& term : g)
+			{
+				long long a = weight(w, leading) - weight(w, term.first); //>= 0
+				long long b = weight(targetWeight, leading) - weight(targetWeight, term.first);
+				if (a > 0 && b < 0 && a * bestDen < bestNum * (a - b)) //t = a/(a-b) < best so far
+				{
+					bestNum = a;
+					bestDen = a - b;
+				}
+			}
+		}
+		if (bestNum == bestDen)
+		{
+			w = targetWeight;
+			last = true;
+		}
+		else
+		{
+			long long divisor = 0; //gcd of the new weights
+			for (size_t i = 0; i < n; ++i) //scaled by bestDen, which preserves the order
+			{
+				w[i] = (bestDen - bestNum) * w[i] + bestNum * targetWeight[i];
+				for (long long x = std::abs(w[i]); x != 0; )
+				{
+					long long temp = divisor % x;
+					divisor = x;
+					x = temp;
+				}
+			}
+			if (divisor > 1)
+				for (long long& weightEntry : w)
+					weightEntry /= divisor;
+		}
+	}
+	return current;
+}
+
+template<class CoefT>
+std::vector<Polynomial<CoefT>> Ideal<CoefT>::divide(P f, const Basis& divisors, const PowerProduct::TermOrder& order)
+{
+	//multivariate division, keeping the quotients and discarding the remainder
+	std::vector<P> quotients(divisors.size());
+	std::vector<PowerProduct> leading;
+	for (const P& d : divisors)
+		leading.push_back(d.leadingPower(order));
+	while (f != 0)
+	{
+		P leadingTerm = f.leadingTerm(order);
+		PowerProduct leadingPower = f.leadingPower(order);
+		auto match = std::find_if(leading.begin(), leading.end(),
+			[&](const PowerProduct& divisor) { return leadingPower.isDivisibleBy(divisor); });
+		if (match == leading.end())
+			f -= leadingTerm; //part of the remainder
+		else
+		{
+			size_t k = match - leading.begin();
+			P quotient = leadingTerm / divisors[k].leadingTerm(order);
+			quotients[k] += quotient;
+			f -= quotient * divisors[k];
+		}
+	}
+	return quotients;
+}
+
+template<class CoefT>
+size_t Ideal<CoefT>::variables() const
+{
+	size_t n = 0;
+	for (const P& p : mGrobner)
+		for (const auto& term : p)
+			n = std::max(n, term.first.variables());
+	return n;
+}
+
+template<class CoefT>
+void Ideal<CoefT>::updateLeading()
+{
+	mLeading.clear();
+	mSupports.clear();
+	for (const P& p : mGrobner)
+	{
+		mLeading.push_back(p.leadingPower(*pTermOrder));
+		mSupports.push_back(support(mLeading.back()));
+	}
+	mMinLeadingDegree = mLeading.empty() ? 0 : std::min_element(mLeading.begin(), mLeading.end(),
+		[](const PowerProduct& l, const PowerProduct& r) { return l.degree() < r.degree(); })->degree();
+}
+
+template<class CoefT>
+template<typename Function>
+void Ideal<CoefT>::forEach(size_t count, Function f) const
+{
+	if (pPool)
+		pPool->forEach(count, f);
+	else
+		for (size_t i = 0; i < count; ++i)
+			f(i);
+}
@@ -0,0 +1,175 @@
+/*
+Notes: Stored ideals are never changed in place. A user takes a shared pointer to the ideal
+under a name and may query it for as long as it likes, without a lock; to change it, the
+user copies it, changes the copy, and stores the copy under the same name. An ideal replaced
+or evicted meanwhile lives on until its last user lets go of it. If two users change the same
+ideal at once, the one stored last wins.
+
+The size of an ideal is estimated from its basis, term by term, as the nodes and degree
+vectors that hold it would take (see NodePool), so the limit on bytes is approximate.
+*/
+
+#pragma once
+#include "Ideal.h"
+#include "NodePool.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Ideals stored by name, with their computed bases, for any number of threads. When there
+// are more ideals or bytes than the limits allow, the least recently used are evicted.
+template <class CoefT>
+class IdealRegistry final
+{
+public:
+	using IdealPtr = std::shared_ptr<const Ideal<CoefT>>;
+
+	// An ideal stored under a name, with its estimated size in bytes.
+	struct Entry
+	{
+		std::string name;
+		IdealPtr ideal;
+		size_t bytes;
+	};
+
+	// Keeps at most maxIdeals ideals and maxBytes bytes of them; 0 for no limit.
+	explicit IdealRegistry(size_t maxIdeals = 0, size_t maxBytes = 0)
+		: mMaxIdeals{ maxIdeals }, mMaxBytes{ maxBytes } {}
+
+	IdealRegistry(const IdealRegistry&) = delete;
+	IdealRegistry& operator=(const IdealRegistry&) = delete;
+
+	// Returns the ideal stored under name, now the most recently used, or null if there is none.
+	IdealPtr find(const std::string& name);
+
+	// Stores ideal under name, replacing any ideal stored under it, then evicts the least
+	// recently used others until the limits are met. Returns the names evicted. An ideal
+	// too large for the limits on its own is still stored.
+	std::vector<std::string> store(const std::string& name, Ideal<CoefT> ideal);
+
+	// Removes the ideal stored under name. Returns false if there was none.
+	bool erase(const std::string& name);
+
+	// Returns the stored ideals, most recently used first.
+	std::vector<Entry> entries() const;
+
+	// Returns the number of ideals stored, and their estimated size in bytes.
+	size_t size() const;
+	size_t bytes() const;
+
+	// Returns the estimated size in bytes of the basis of ideal.
+	static size_t footprint(const Ideal<CoefT>& ideal);
+
+private:
+	mutable std::mutex mMutex; //guards the rest
+	std::list<Entry> mEntries; //most recently used first
+	std::unordered_map<std::string, typename std::list<Entry>::iterator> mIndex; //into mEntries
+	size_t mMaxIdeals;
+	size_t mMaxBytes;
+	size_t mBytes{ 0 }; //of all the entries
+
+	//round bytes up to the size of block NodePool would use
+	static size_t block(size_t bytes)
+	{
+		return (bytes + NodePool::granularity - 1) / NodePool::granularity * NodePool::granularity;
+	}
+};
+
+template <class CoefT>
+typename IdealRegistry<CoefT>::IdealPtr IdealRegistry<CoefT>::find(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto found = mIndex.find(name);
+	if (found == mIndex.end())
+		return nullptr;
+	mEntries.splice(mEntries.begin(), mEntries, found->second); //iterators stay valid
+	return found->second->ideal;
+}
+
+template <class CoefT>
+std::vector<std::string> IdealRegistry<CoefT>::store(const std::string& name, Ideal<CoefT> ideal)
+{
+	size_t bytes = footprint(ideal);
+	IdealPtr stored = std::make_shared<const Ideal<CoefT>>(std::move(ideal));
+	std::vector<IdealPtr> released; //freed after unlocking, as bases may be large
+	std::vector<std::string> evicted;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto found = mIndex.find(name);
+	if (found != mIndex.end())
+	{
+		released.push_back(std::move(found->second->ideal));
+		mBytes -= found->second->bytes;
+		mEntries.erase(found->second);
+	}
+	mEntries.push_front({ name, std::move(stored), bytes });
+	mIndex[name] = mEntries.begin();
+	mBytes += bytes;
+
+	while (mEntries.size() > 1 && ((mMaxIdeals != 0 && mEntries.size() > mMaxIdeals)
+		|| (mMaxBytes != 0 && mBytes > mMaxBytes)))
+	{
+		Entry& last = mEntries.back();
+		evicted.push_back(last.name);
+		released.push_back(std::move(last.ideal));
+		mBytes -= last.bytes;
+		mIndex.erase(last.name);
+		mEntries.pop_back();
+	}
+	return evicted;
+}
+
+template <class CoefT>
+bool IdealRegistry<CoefT>::erase(const std::string& name)
+{
+	IdealPtr released;
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto found = mIndex.find(name);
+	if (found == mIndex.end())
+		return false;
+	released = std::move(found->second->ideal);
+	mBytes -= found->second->bytes;
+	mEntries.erase(found->second);
+	mIndex.erase(found);
+	return true;
+}
+
+template <class CoefT>
+std::vector<typename IdealRegistry<CoefT>::Entry> IdealRegistry<CoefT>::entries() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return std::vector<Entry>(mEntries.begin(), mEntries.end());
+}
+
+template <class CoefT>
+size_t IdealRegistry<CoefT>::size() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
+
+template <class CoefT>
+size_t IdealRegistry<CoefT>::bytes() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mBytes;
+}
+
+template <class CoefT>
+size_t IdealRegistry<CoefT>::footprint(const Ideal<CoefT>& ideal)
+{
+	//a map node is the term and about four pointers' worth of links and colour
+	constexpr size_t node = sizeof(std::pair<const PowerProduct, CoefT>) + 4 * sizeof(void*);
+	size_t bytes = sizeof(Ideal<CoefT>);
+	for (const auto& g : ideal)
+	{
+		bytes += sizeof(Polynomial<CoefT>) + sizeof(PowerProduct); //the element and its leading power
+		for (const auto& term : g)
+			bytes += block(node) + (term.first.variables() == 0 ? 0 : block(term.first.variables() * sizeof(int)));
+	}
+	return bytes;
+}
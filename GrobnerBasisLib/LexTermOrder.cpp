@@ -7,10 +7,18 @@ Date: 5/12/2022
 #include <algorithm>
 using namespace std;
 
-bool LexTermOrder::compare(const vector<int>& leftDegrees, const vector<int>& rightDegrees) const
+bool LexTermOrder::compare(const PowerProduct::Degrees& leftDegrees, const PowerProduct::Degrees& rightDegrees) const
 {
     return lexicographical_compare(
         leftDegrees.begin(), leftDegrees.end(),
         rightDegrees.begin(), rightDegrees.end()
     );
 }
+
+PowerProduct::TermOrder::Matrix LexTermOrder::matrix(size_t n) const
+{
+    Matrix identity(n, vector<long long>(n));
+    for (size_t i = 0; i < n; ++i)
+        identity[i][i] = 1;
+    return identity;
+}
@@ -5,5 +5,10 @@
 class LexTermOrder :
     public PowerProduct::TermOrder
 {
-    bool compare(const std::vector<int>& leftDegrees, const std::vector<int>& rightDegrees) const override;
+public:
+    // The identity matrix.
+    Matrix matrix(size_t n) const override;
+
+private:
+    bool compare(const PowerProduct::Degrees& leftDegrees, const PowerProduct::Degrees& rightDegrees) const override;
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "MappedFile.h"
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::system_error(GetLastError(), std::system_category(), "cannot open " + path.string());
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		DWORD error = GetLastError();
+		CloseHandle(file);
+		throw std::system_error(error, std::system_category(), "cannot read size of " + path.string());
+	}
+	mSize = static_cast<size_t>(size.QuadPart);
+	if (mSize == 0) //an empty file cannot be mapped
+	{
+		CloseHandle(file);
+		return;
+	}
+
+	//the view keeps the mapping alive, so neither handle is needed after this
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	DWORD error = GetLastError();
+	CloseHandle(file);
+	if (!mapping)
+		throw std::system_error(error, std::system_category(), "cannot map " + path.string());
+	mData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	error = GetLastError();
+	CloseHandle(mapping);
+	if (!mData)
+		throw std::system_error(error, std::system_category(), "cannot map " + path.string());
+}
+
+MappedFile::~MappedFile()
+{
+	if (mData)
+		UnmapViewOfFile(mData);
+}
+
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		int error = errno;
+		close(file);
+		throw std::system_error(error, std::generic_category(), "cannot read size of " + path.string());
+	}
+	mSize = static_cast<size_t>(status.st_size);
+	if (mSize == 0) //an empty file cannot be mapped
+	{
+		close(file);
+		return;
+	}
+
+	//the mapping outlives the descriptor
+	void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+	int error = errno;
+	close(file);
+	if (data == MAP_FAILED)
+		throw std::system_error(error, std::generic_category(), "cannot map " + path.string());
+	mData = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile()
+{
+	if (mData)
+		munmap(const_cast<char*>(mData), mSize);
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: mData{ std::exchange(other.mData, nullptr) }, mSize{ std::exchange(other.mSize, 0) } {}
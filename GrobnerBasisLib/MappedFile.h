@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+// A file mapped read-only into memory, so it can be read in place without copying it.
+class MappedFile final
+{
+public:
+	// Maps the whole file. Throws std::system_error if it cannot be opened or mapped.
+	explicit MappedFile(const std::filesystem::path& path);
+
+	// Unmaps the file.
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// The contents of the file; null if it is empty.
+	const char* data() const { return mData; }
+
+	// The size of the file in bytes.
+	size_t size() const { return mSize; }
+
+private:
+	const char* mData{ nullptr };
+	size_t mSize{ 0 };
+};
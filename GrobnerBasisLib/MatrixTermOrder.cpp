@@ -0,0 +1,60 @@
+#include "MatrixTermOrder.h"
+#include <algorithm>
+
+namespace
+{
+	//the dot product of a row of weights with a vector of degrees
+	long long dot(const std::vector<long long>& row, const PowerProduct::Degrees& degrees)
+	{
+		long long sum = 0;
+		for (size_t i = 0; i < row.size() && i < degrees.size(); ++i)
+			sum += row[i] * degrees[i];
+		return sum;
+	}
+}
+
+MatrixTermOrder::MatrixTermOrder(Matrix rows)
+	: mRows{ std::move(rows) }
+{
+	size_t columns = 0;
+	for (const auto& row : mRows)
+		columns = std::max(columns, row.size());
+	for (size_t i = 0; i < columns; ++i) //the first nonzero weight of each variable decides it
+		for (const auto& row : mRows)
+			if (i < row.size() && row[i] != 0)
+			{
+				if (row[i] < 0)
+					throw std::logic_error("matrix term order is not a well-ordering");
+				break;
+			}
+}
+
+PowerProduct::TermOrder::Matrix MatrixTermOrder::matrix(size_t n) const
+{
+	Matrix rows;
+	for (const auto& row : mRows)
+	{
+		rows.push_back(row);
+		rows.back().resize(n);
+	}
+	for (size_t i = 0; i < n; ++i) //lex tie-break
+	{
+		rows.emplace_back(n);
+		rows.back()[i] = 1;
+	}
+	return rows;
+}
+
+bool MatrixTermOrder::compare(const PowerProduct::Degrees& lDegrees, const PowerProduct::Degrees& rDegrees) const
+{
+	for (const auto& row : mRows)
+	{
+		long long l = dot(row, lDegrees), r = dot(row, rDegrees);
+		if (l != r)
+			return l < r;
+	}
+	return std::lexicographical_compare( //break ties with lex
+		lDegrees.begin(), lDegrees.end(),
+		rDegrees.begin(), rDegrees.end()
+	);
+}
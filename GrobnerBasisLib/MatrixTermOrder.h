@@ -0,0 +1,22 @@
+#pragma once
+#include "PowerProduct.h"
+
+// Compares power products by weights: by their dot products with the first row of a matrix,
+// ties broken by the next row, and so on, with any remaining ties broken lexicographically.
+// A single row gives a weight order. The rows may have any length; missing weights are zero.
+class MatrixTermOrder final :
+	public PowerProduct::TermOrder
+{
+public:
+	// Constructs the order with the given rows. Throws std::logic_error if it would not be
+	// a well-ordering, i.e., if the first nonzero weight of some variable is negative.
+	explicit MatrixTermOrder(Matrix rows);
+
+	// The rows, padded or truncated to n entries, followed by the identity (lex).
+	Matrix matrix(size_t n) const override;
+
+private:
+	Matrix mRows;
+
+	bool compare(const PowerProduct::Degrees& lDegrees, const PowerProduct::Degrees& rDegrees) const override;
+};
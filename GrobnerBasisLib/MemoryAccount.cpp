@@ -0,0 +1,77 @@
+#include "MemoryAccount.h"
+
+const char* MemoryAccount::name(Category category)
+{
+	switch (category)
+	{
+	case Basis:
+		return "basis";
+	case Pairs:
+		return "pairs";
+	case Temporaries:
+		return "temporaries";
+	default:
+		return "unknown";
+	}
+}
+
+size_t MemoryAccount::current(Category category) const
+{
+	size_t bytes = mUsage[category].current.load(std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(mThreadsMutex);
+	for (const auto& thread : mThreads)
+		bytes += thread.second->pending[category].load(std::memory_order_relaxed);
+	return bytes;
+}
+
+size_t MemoryAccount::current() const
+{
+	size_t bytes = mTotal.current.load(std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(mThreadsMutex);
+	for (const auto& thread : mThreads)
+		for (const auto& pending : thread.second->pending)
+			bytes += pending.load(std::memory_order_relaxed);
+	return bytes;
+}
+
+void MemoryAccount::resetPeaks()
+{
+	for (int c = 0; c < Categories; ++c)
+		mUsage[c].peak.store(current(static_cast<Category>(c)), std::memory_order_relaxed);
+	mTotal.peak.store(current(), std::memory_order_relaxed);
+}
+
+MemoryAccount::Changes& MemoryAccount::addThread()
+{
+	std::lock_guard<std::mutex> lock(mThreadsMutex);
+	std::thread::id id = std::this_thread::get_id();
+	for (auto& thread : mThreads)
+		if (thread.first == id)
+			return *thread.second;
+	mThreads.emplace_back(id, std::make_unique<Changes>());
+	return *mThreads.back().second;
+}
+
+void MemoryAccount::flush(Changes& changes) noexcept
+{
+	//the totals are added to before the changes are cleared, so a concurrent reader may count
+	//them twice for a moment, but never misses them
+	for (int c = 0; c < Categories; ++c)
+	{
+		ptrdiff_t pending = changes.pending[c].load(std::memory_order_relaxed);
+		size_t before = mUsage[c].current.fetch_add(static_cast<size_t>(pending), std::memory_order_relaxed);
+		changes.pending[c].store(0, std::memory_order_relaxed);
+		raise(mUsage[c].peak, before + static_cast<size_t>(changes.high[c]));
+		changes.high[c] = 0;
+	}
+	size_t before = mTotal.current.fetch_add(static_cast<size_t>(changes.total), std::memory_order_relaxed);
+	raise(mTotal.peak, before + static_cast<size_t>(changes.totalHigh));
+	changes.total = 0;
+	changes.totalHigh = 0;
+}
+
+void MemoryAccount::raise(std::atomic<size_t>& peak, size_t value)
+{
+	size_t seen = peak.load(std::memory_order_relaxed);
+	while (seen < value && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+}
@@ -0,0 +1,310 @@
+/*
+Notes: A CountingAllocator is bound to an account and category when it is made: explicitly,
+or by default from the MemoryAccount::Scope active on the current thread. Containers keep
+their allocator, so memory is returned to the category it was charged to, wherever it is
+freed. A copy of a container takes the current scope rather than the original's, so copying
+a polynomial under a new scope moves its charge there; a move keeps the original's.
+With no scope active, the allocators charge nothing and cost a null check. Either way the
+memory itself comes from NodePool. The allocators hold a plain pointer to the account, so
+the account must outlive every container charged to it.
+
+Besides the blocks it allocates, the allocator charges what the values it constructs keep on
+the heap, as given by heapBytes: the degrees of the PowerProduct in each term, for example.
+
+Each thread counts its own changes to an account, and adds them to the shared totals every
+flushBytes of change and when a Scope for the account ends, so the allocators touch no
+shared memory in between. The current counts sum the totals and every thread's changes;
+a peak is taken from the totals and the most the thread's changes reached when they are
+added, so it is exact for a single thread and may miss the moments several threads peak at
+once. The limit is checked against the totals and the allocating thread's changes.
+*/
+
+#pragma once
+#include "NodePool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Counts the bytes allocated through CountingAllocator, in use and at peak, by category, and
+// enforces a soft limit on the total in use. May be used from any number of threads.
+class MemoryAccount final
+{
+public:
+	// What the memory is used for.
+	enum Category
+	{
+		Basis, // the terms of basis elements
+		Pairs, // queued critical pairs
+		Temporaries, // the terms of polynomials being computed, such as S-polynomials
+		Categories // the number of categories
+	};
+
+	// Thrown by an allocation that would take the total in use over the limit.
+	class LimitException : public std::bad_alloc
+	{
+	public:
+		explicit LimitException(size_t limit)
+			: mMessage{ "memory limit of " + std::to_string(limit) + " bytes exceeded" } {}
+		const char* what() const noexcept override { return mMessage.c_str(); }
+	private:
+		std::string mMessage;
+	};
+
+	// While a Scope exists, CountingAllocators made by default on its thread charge account
+	// (if not null) under category. Scopes nest; the previous one is restored on destruction,
+	// after the changes this thread counted for account are flushed.
+	class Scope final
+	{
+	public:
+		Scope(MemoryAccount* account, Category category)
+			: mPrevious{ current }
+		{
+			current = { account, category };
+		}
+		~Scope()
+		{
+			if (current.account)
+				current.account->flush();
+			current = mPrevious;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		friend class MemoryAccount;
+		struct Binding
+		{
+			MemoryAccount* account;
+			Category category;
+		};
+		Binding mPrevious;
+		static inline thread_local Binding current{ nullptr, Temporaries };
+	};
+
+	// The change in the bytes counted on a thread at which it is added to the totals.
+	static constexpr ptrdiff_t flushBytes = 64 * 1024;
+
+	MemoryAccount() : mSerial{ ++serials } {}
+	MemoryAccount(const MemoryAccount&) = delete;
+	MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+	// Returns the name of category, such as "basis".
+	static const char* name(Category category);
+
+	// Returns the bytes in use in category, or in all of them.
+	size_t current(Category category) const;
+	size_t current() const;
+
+	// Returns the most bytes in use at once in category, or in all of them, since construction
+	// or resetPeaks.
+	size_t peak(Category category) const
+	{
+		return std::max(mUsage[category].peak.load(std::memory_order_relaxed), current(category));
+	}
+	size_t peak() const { return std::max(mTotal.peak.load(std::memory_order_relaxed), current()); }
+
+	// Sets each peak to the bytes now in use.
+	void resetPeaks();
+
+	// Sets the most bytes that may be in use in all categories together; 0 (the default) for
+	// no limit. Memory already in use is not freed.
+	void setLimit(size_t bytes) { mLimit.store(bytes, std::memory_order_relaxed); }
+
+	// Returns the limit, or 0 if there is none.
+	size_t limit() const { return mLimit.load(std::memory_order_relaxed); }
+
+	// Charges bytes to category. Throws LimitException, charging nothing, if that would take
+	// the total over the limit.
+	void allocate(Category category, size_t bytes)
+	{
+		Changes& changes = threadChanges();
+		size_t limit = mLimit.load(std::memory_order_relaxed);
+		if (limit != 0 && mTotal.current.load(std::memory_order_relaxed) + changes.total + bytes > limit)
+			throw LimitException(limit);
+		change(changes, category, static_cast<ptrdiff_t>(bytes));
+	}
+
+	// Returns bytes charged to category.
+	void deallocate(Category category, size_t bytes) noexcept
+	{
+		change(threadChanges(), category, -static_cast<ptrdiff_t>(bytes));
+	}
+
+	// Adds the changes counted on this thread to the totals, raising the peaks.
+	void flush() { flush(threadChanges()); }
+
+	// Returns the account and category of the scope active on this thread; the account is
+	// null if there is none.
+	static MemoryAccount* scopeAccount() { return Scope::current.account; }
+	static Category scopeCategory() { return Scope::current.category; }
+
+private:
+	struct Usage
+	{
+		std::atomic<size_t> current{ 0 };
+		std::atomic<size_t> peak{ 0 };
+	};
+	std::array<Usage, Categories> mUsage;
+	Usage mTotal;
+	std::atomic<size_t> mLimit{ 0 };
+
+	//the changes one thread has counted since it last flushed them; only that thread writes them
+	struct alignas(64) Changes
+	{
+		std::array<std::atomic<ptrdiff_t>, Categories> pending{};
+		std::array<ptrdiff_t, Categories> high{}; //the most pending has reached, by category
+		ptrdiff_t total{ 0 }; //the sum of pending
+		ptrdiff_t totalHigh{ 0 };
+	};
+	std::vector<std::pair<std::thread::id, std::unique_ptr<Changes>>> mThreads;
+	mutable std::mutex mThreadsMutex;
+
+	//tells the accounts apart in the threads' caches, never reused
+	const unsigned long long mSerial;
+	static inline std::atomic<unsigned long long> serials{ 0 };
+
+	//the changes of this thread, found in its cache of the accounts it used last
+	Changes& threadChanges()
+	{
+		static thread_local std::array<std::pair<unsigned long long, Changes*>, 4> recent{};
+		auto& entry = recent[mSerial % recent.size()];
+		if (entry.first != mSerial)
+			entry = { mSerial, &addThread() };
+		return *entry.second;
+	}
+
+	//the changes of this thread, made if it has none
+	Changes& addThread();
+
+	//count a change of bytes in category, flushing if the changes have grown large
+	void change(Changes& changes, Category category, ptrdiff_t bytes) noexcept
+	{
+		ptrdiff_t pending = changes.pending[category].load(std::memory_order_relaxed) + bytes;
+		changes.pending[category].store(pending, std::memory_order_relaxed);
+		changes.high[category] = std::max(changes.high[category], pending);
+		changes.total += bytes;
+		changes.totalHigh = std::max(changes.totalHigh, changes.total);
+		if (changes.total > flushBytes || changes.total < -flushBytes)
+			flush(changes);
+	}
+
+	//add changes to the totals
+	void flush(Changes& changes) noexcept;
+
+	//raise peak to at least value
+	static void raise(std::atomic<size_t>& peak, size_t value);
+};
+
+// Returns the bytes value keeps on the heap, which CountingAllocator charges along with the
+// value itself. Types that keep any overload it, to be found by argument-dependent lookup;
+// the result must not change while the value is in a container.
+template <typename T>
+size_t heapBytes(const T&) { return 0; }
+
+template <typename T, typename U>
+size_t heapBytes(const std::pair<T, U>& value) { return heapBytes(value.first) + heapBytes(value.second); }
+
+// A standard allocator that charges what it allocates to a MemoryAccount (see the notes above).
+template <typename T>
+class CountingAllocator
+{
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+	using is_always_equal = std::false_type;
+
+	// Charges the account and category of the scope active on this thread, if any.
+	CountingAllocator()
+		: mAccount{ MemoryAccount::scopeAccount() }, mCategory{ MemoryAccount::scopeCategory() } {}
+
+	// Charges account, if not null, under category.
+	CountingAllocator(MemoryAccount* account, MemoryAccount::Category category)
+		: mAccount{ account }, mCategory{ category } {}
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>& other)
+		: mAccount{ other.mAccount }, mCategory{ other.mCategory } {}
+
+	T* allocate(size_t n)
+	{
+		if (!mAccount)
+			return PoolAllocator<T>().allocate(n);
+		mAccount->allocate(mCategory, n * sizeof(T));
+		try
+		{
+			return PoolAllocator<T>().allocate(n);
+		}
+		catch (...)
+		{
+			mAccount->deallocate(mCategory, n * sizeof(T));
+			throw;
+		}
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		PoolAllocator<T>().deallocate(p, n);
+		if (mAccount)
+			mAccount->deallocate(mCategory, n * sizeof(T));
+	}
+
+	// Constructs a U at p, charging the bytes it keeps on the heap.
+	template <typename U, typename... Args>
+	void construct(U* p, Args&&... args)
+	{
+		::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		size_t bytes = mAccount ? heapBytes(*p) : 0;
+		if (bytes == 0)
+			return;
+		try
+		{
+			mAccount->allocate(mCategory, bytes);
+		}
+		catch (...)
+		{
+			p->~U();
+			throw;
+		}
+	}
+
+	// Destroys the U at p, returning the bytes it kept on the heap.
+	template <typename U>
+	void destroy(U* p) noexcept
+	{
+		if (mAccount)
+			if (size_t bytes = heapBytes(*p))
+				mAccount->deallocate(mCategory, bytes);
+		p->~U();
+	}
+
+	// Copies of containers are charged to the current scope.
+	CountingAllocator select_on_container_copy_construction() const { return CountingAllocator(); }
+
+	friend bool operator==(const CountingAllocator& left, const CountingAllocator& right)
+	{
+		return left.mAccount == right.mAccount && left.mCategory == right.mCategory;
+	}
+	friend bool operator!=(const CountingAllocator& left, const CountingAllocator& right)
+	{
+		return !(left == right);
+	}
+
+private:
+	template <typename U>
+	friend class CountingAllocator;
+
+	MemoryAccount* mAccount;
+	MemoryAccount::Category mCategory;
+};
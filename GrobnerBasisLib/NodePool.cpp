@@ -0,0 +1,22 @@
+#include "NodePool.h"
+
+size_t NodePool::keptBytes()
+{
+	size_t bytes = 0;
+	for (size_t c = 0; c < sizeClasses; ++c)
+		bytes += cache.counts[c] * (c + 1) * granularity;
+	return bytes;
+}
+
+void NodePool::release() noexcept
+{
+	for (size_t c = 0; c < sizeClasses; ++c)
+	{
+		while (Block* block = cache.heads[c])
+		{
+			cache.heads[c] = block->next;
+			::operator delete(block);
+		}
+		cache.counts[c] = 0;
+	}
+}
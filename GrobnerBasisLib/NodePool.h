@@ -0,0 +1,125 @@
+/*
+Notes: Reduction makes and discards polynomials at a great rate, each term a map node and a
+vector of degrees, all small blocks of a few sizes. While a NodePool::Scope is open on a
+thread, small blocks freed there are kept in that thread's free lists, by size, and handed
+out again instead of going back to the heap. When the outermost scope on the thread closes,
+its free lists are released in one go, so nothing is held between computations. Small
+blocks are always rounded up to their size class, so any of them can be kept, whichever
+thread made it and whether or not a scope was open then. A kept block is an ordinary heap
+block, so a polynomial that outlives the scope, such as a new basis element, keeps its
+memory without being copied, and frees it to the heap as usual.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Per-thread caches of small memory blocks for short-lived polynomials.
+class NodePool final
+{
+public:
+	// The largest block kept, and the step between sizes kept.
+	static constexpr size_t maxBlockBytes = 256;
+	static constexpr size_t granularity = 16;
+
+	// The most blocks of each size kept by a thread.
+	static constexpr uint32_t maxBlocksPerSize = 4096;
+
+	// While a Scope is open, small blocks freed on its thread are kept and reused. Scopes
+	// nest; the outermost releases the blocks kept when it closes.
+	class Scope final
+	{
+	public:
+		Scope() { ++cache.depth; }
+		~Scope()
+		{
+			if (--cache.depth == 0)
+				release();
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	// Returns a block of at least bytes bytes.
+	static void* allocate(size_t bytes)
+	{
+		if (bytes > maxBlockBytes)
+			return ::operator new(bytes);
+		size_t c = sizeClass(bytes);
+		if (cache.heads[c])
+		{
+			Block* block = cache.heads[c];
+			cache.heads[c] = block->next;
+			--cache.counts[c];
+			return block;
+		}
+		return ::operator new((c + 1) * granularity);
+	}
+
+	// Frees a block returned by allocate(bytes).
+	static void deallocate(void* p, size_t bytes) noexcept
+	{
+		if (bytes <= maxBlockBytes && cache.depth > 0)
+		{
+			size_t c = sizeClass(bytes);
+			if (cache.counts[c] < maxBlocksPerSize)
+			{
+				cache.heads[c] = new (p) Block{ cache.heads[c] };
+				++cache.counts[c];
+				return;
+			}
+		}
+		::operator delete(p);
+	}
+
+	// Returns the bytes kept by this thread.
+	static size_t keptBytes();
+
+private:
+	static constexpr size_t sizeClasses = maxBlockBytes / granularity;
+
+	//a kept block, linked through its first bytes
+	struct Block
+	{
+		Block* next;
+	};
+
+	//the free lists of a thread; constant-initialized, so access needs no guard
+	struct Cache
+	{
+		std::array<Block*, sizeClasses> heads;
+		std::array<uint32_t, sizeClasses> counts;
+		int depth; //of open scopes
+	};
+	static inline thread_local Cache cache{};
+
+	//the index of the free list for blocks of bytes
+	static size_t sizeClass(size_t bytes) { return bytes == 0 ? 0 : (bytes - 1) / granularity; }
+
+	//free the blocks kept by this thread
+	static void release() noexcept;
+};
+
+// A stateless standard allocator drawing on NodePool.
+template <typename T>
+class PoolAllocator
+{
+public:
+	static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned type");
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	PoolAllocator() = default;
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n) { return static_cast<T*>(NodePool::allocate(n * sizeof(T))); }
+	void deallocate(T* p, size_t n) noexcept { NodePool::deallocate(p, n * sizeof(T)); }
+
+	friend bool operator==(const PoolAllocator&, const PoolAllocator&) { return true; }
+	friend bool operator!=(const PoolAllocator&, const PoolAllocator&) { return false; }
+};
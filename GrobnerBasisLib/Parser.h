@@ -21,6 +21,14 @@ public:
 	public:
 		explicit ParseException() {}
 		explicit ParseException(std::string message) : std::runtime_error(message) {}
+		ParseException(std::string message, size_t position)
+			: std::runtime_error(message), mPosition{ position } {}
+
+		// The offset in the input where the error was found, or npos if unknown.
+		size_t position() const { return mPosition; }
+
+	private:
+		size_t mPosition{ std::string::npos };
 	};
 };
 
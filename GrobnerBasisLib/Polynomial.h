@@ -6,9 +6,14 @@ Date: 5/11/2022
 #pragma once
 #include "PowerProduct.h"
 #include "LexTermOrder.h"
+#include "MemoryAccount.h"
 #include <map>
 #include <algorithm>	
 #include <string>
+#include <sstream>
+#include <iterator>
+#include <typeinfo>
+#include <vector>
 
 
 // A polynomial is a sum of coefficients times product powers. They may be added, subtracted,
@@ -40,6 +45,17 @@ public:
 	Polynomial(int constant) 
 		: Polynomial(CoefT(constant)) {}
 
+	// Constructs the sum of the terms in the range [first,last), pairs of a power product
+	// and a coefficient. Repeated power products are added together. Takes linear time if
+	// the terms are in increasing lex order, the order begin() and end() visit them in.
+	template <typename TermIterator, typename = typename std::iterator_traits<TermIterator>::value_type>
+	Polynomial(TermIterator first, TermIterator last)
+	{
+		for (auto it = first; it != last; ++it)
+			mTerms.emplace_hint(mTerms.end(), it->first, CoefT(0))->second += it->second;
+		simplify();
+	}
+
 	friend bool operator==(const Polynomial& left, const Polynomial& right)
 	{
 		return left.mTerms == right.mTerms;
@@ -128,6 +144,21 @@ public:
 	// Returns the leading term of this polynomial, as determined by termOrder.
 	Polynomial leadingTerm(const PowerProduct::TermOrder& termOrder) const;
 	
+	// Returns the coefficient of powerProduct in this polynomial (0 if it is not a term).
+	CoefT coefficient(const PowerProduct& powerProduct) const
+	{
+		auto it = mTerms.find(powerProduct);
+		return it == mTerms.end() ? CoefT(0) : it->second;
+	}
+
+	// Iterators over the terms, pairs of a power product and its (nonzero) coefficient,
+	// in increasing lex order.
+	auto begin() const { return mTerms.cbegin(); }
+	auto end() const { return mTerms.cend(); }
+
+	// Returns the number of terms.
+	size_t size() const { return mTerms.size(); }
+
 	// Converts this polynomial to a string using a Printer.
 	// Terms are printed in an unspecified order.
 	std::string toString(Printer<CoefT>& printer) const;
@@ -136,6 +167,14 @@ public:
 	// Terms are printed in the specified order, greatest to least.
 	std::string toString(Printer<CoefT>& printer,const PowerProduct::TermOrder& termOrder) const;
 
+	// Writes this polynomial directly to out using a Printer, as toString would return it.
+	// Terms are written in an unspecified order.
+	void print(std::ostream& out, Printer<CoefT>& printer) const;
+
+	// Writes this polynomial directly to out using a Printer, as toString would return it.
+	// Terms are written in the specified order, greatest to least, without copying them.
+	void print(std::ostream& out, Printer<CoefT>& printer, const PowerProduct::TermOrder& termOrder) const;
+
 private:
 	//The term order used internally.
 	using Ord = LexTermOrder;
@@ -144,7 +183,8 @@ private:
 	//That is, mTerms[p] is the coefficient of power product p.
 	//Sorted with respect to Ord.
 	//Entries with value zero are always removed.
-	std::map<PowerProduct, CoefT, Ord> mTerms;
+	//The nodes are charged to the MemoryAccount scope active when the map was made.
+	std::map<PowerProduct, CoefT, Ord, CountingAllocator<std::pair<const PowerProduct, CoefT>>> mTerms;
 
 	//strip off any zero terms
 	void simplify();
@@ -219,21 +259,45 @@ Polynomial<CoefT> Polynomial<CoefT>::leadingTerm(const PowerProduct::TermOrder&
 template <typename CoefT>
 std::string Polynomial<CoefT>::toString(Printer<CoefT>& printer) const
 {
-	for (auto it = mTerms.rbegin(); it != mTerms.rend(); ++it)
-		printer.addTerm(it->second,it->first); 
-	return printer.print();
+	std::ostringstream ss;
+	print(ss, printer);
+	return ss.str();
 }
 
 template<typename CoefT>
 std::string Polynomial<CoefT>::toString(Printer<CoefT>& printer, const PowerProduct::TermOrder& termOrder) const
 {
-	//sort the terms according to termOrder
-	std::map<PowerProduct, CoefT, const PowerProduct::TermOrder&> sortedTerms(
-		mTerms.begin(),mTerms.end(),termOrder 
-	);
-	for (auto it = sortedTerms.rbegin(); it != sortedTerms.rend(); ++it) 
-		printer.addTerm(it->second,it->first);//add terms in reverse order, so leading term is first
-	return printer.print();
+	std::ostringstream ss;
+	print(ss, printer, termOrder);
+	return ss.str();
+}
+
+template <typename CoefT>
+void Polynomial<CoefT>::print(std::ostream& out, Printer<CoefT>& printer) const
+{
+	if (mTerms.empty())
+		printer.writeZero(out);
+	for (auto it = mTerms.rbegin(); it != mTerms.rend(); ++it)
+		printer.writeTerm(out, it->second, it->first, it == mTerms.rbegin());
+}
+
+template<typename CoefT>
+void Polynomial<CoefT>::print(std::ostream& out, Printer<CoefT>& printer, const PowerProduct::TermOrder& termOrder) const
+{
+	if (typeid(termOrder) == typeid(Ord)) //already in order
+		return print(out, printer);
+
+	//sort pointers to the terms according to termOrder, greatest first
+	std::vector<const typename decltype(mTerms)::value_type*> sortedTerms;
+	sortedTerms.reserve(mTerms.size());
+	for (const auto& term : mTerms)
+		sortedTerms.push_back(&term);
+	std::sort(sortedTerms.begin(), sortedTerms.end(), [&](auto left, auto right) { return termOrder(right->first, left->first); });
+
+	if (sortedTerms.empty())
+		printer.writeZero(out);
+	for (auto it = sortedTerms.begin(); it != sortedTerms.end(); ++it)
+		printer.writeTerm(out, (*it)->second, (*it)->first, it == sortedTerms.begin());
 }
 
 template<typename CoefT>
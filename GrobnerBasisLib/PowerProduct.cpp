@@ -6,6 +6,17 @@ Date: 5/12/2022
 #include "PowerProduct.h"
 #include <stdexcept>
 #include <utility>
+#include <numeric>
+#include <algorithm>
+
+PowerProduct::PowerProduct(std::vector<int> degrees)
+	: mDegrees(degrees.begin(), degrees.end())
+{
+	if (std::any_of(mDegrees.begin(), mDegrees.end(), [](int d) { return d < 0; }))
+		throw std::logic_error("negative degree");
+	while (!mDegrees.empty() && mDegrees.back() == 0)
+		mDegrees.pop_back(); //no trailing zeroes
+}
 
 PowerProduct PowerProduct::operator*(const PowerProduct& right) const {
 	
@@ -65,3 +76,17 @@ PowerProduct PowerProduct::lcm(const PowerProduct& other) const
 		result.mDegrees[i] = std::max(result.mDegrees[i], other.mDegrees[i]); //element-wise max
 	return result;
 }
+
+bool PowerProduct::isCoprimeTo(const PowerProduct& other) const
+{
+	size_t shared = std::min(mDegrees.size(), other.mDegrees.size());
+	for (size_t i = 0; i < shared; ++i)
+		if (mDegrees[i] != 0 && other.mDegrees[i] != 0)
+			return false;
+	return true;
+}
+
+int PowerProduct::degree() const
+{
+	return std::accumulate(mDegrees.begin(), mDegrees.end(), 0);
+}
@@ -10,6 +10,7 @@ Notes: See PowerProductUML for a Unified Modeling Language description of this c
 #include <memory>
 #include <initializer_list>
 #include "Printer.h"
+#include "NodePool.h"
 
 // This class models a product of powers of a collection of variables, such as x^2*y^3*z.
 // There is no limit on the number of variables. These power products can be multiplied, 
@@ -19,12 +20,19 @@ Notes: See PowerProductUML for a Unified Modeling Language description of this c
 class PowerProduct final
 {
 public:
+	// The degree of each variable, in order, as a power product stores them.
+	using Degrees = std::vector<int, PoolAllocator<int>>;
+
 	// Constructs the power product 1.
 	explicit PowerProduct() = default;
 
 	// Constructs the power product x_n, the nth variable.
 	explicit PowerProduct(size_t n) : mDegrees(n + 1) { mDegrees[n] = 1; }
 
+	// Constructs the power product with the given degree of each variable, in order.
+	// Throws if a degree is negative.
+	explicit PowerProduct(std::vector<int> degrees);
+
 	bool operator==(const PowerProduct& right) const { return mDegrees == right.mDegrees; }
 	bool operator!=(const PowerProduct& right) const { return !(*this == right); }
 
@@ -47,31 +55,63 @@ public:
 	// Returns the least common multiple of this and other
 	PowerProduct lcm(const PowerProduct& other) const;
 
+	// Returns true if no variable is present in both this and other, i.e., their least
+	// common multiple is their product.
+	bool isCoprimeTo(const PowerProduct& other) const;
+
+	// Returns the total degree, the sum of the degrees of all variables.
+	int degree() const;
+
+	// Returns the degree of the nth variable.
+	int degree(size_t n) const { return n < mDegrees.size() ? mDegrees[n] : 0; }
+
+	// Returns the number of variables up to and including the last one with nonzero degree.
+	// That is, x_n is the last variable present if variables() == n + 1.
+	size_t variables() const { return mDegrees.size(); }
+
+	// Returns the bytes p keeps on the heap for its degrees, which a CountingAllocator charges
+	// with each term of a polynomial.
+	friend size_t heapBytes(const PowerProduct& p) { return p.mDegrees.capacity() * sizeof(int); }
+
 	// Convert to a string using a Printer.
 	template<typename Coef>
 	std::string toString(Printer<Coef>& printer) const
 	{
 		//mDegrees itself can stay completely private, hiding all implementation details
-		return printer.powerProductString(mDegrees);
+		return printer.powerProductString(mDegrees.data(), mDegrees.data() + mDegrees.size());
 	}
 
+	// Write directly to out using a Printer.
+	template<typename Coef>
+	void print(std::ostream& out, Printer<Coef>& printer) const { printer.writePowerProduct(out, mDegrees.data(), mDegrees.data() + mDegrees.size()); }
+
 	// Interface for comparing power products. 
 	class TermOrder
 	{
 	public:
+		// Rows of weights, one entry per variable.
+		using Matrix = std::vector<std::vector<long long>>;
+
+		virtual ~TermOrder() = default;
+
 		//Returns true if left < right.
 		bool operator() (const PowerProduct& left, const PowerProduct& right) const
 		{
 			//delegate to a private virtual method
 			return compare(left.mDegrees, right.mDegrees);
 		}
+
+		// Returns a matrix describing this order on power products in the first n variables:
+		// they compare as their dot products with the first row, ties broken by the next row,
+		// and so on. Returns an empty matrix if the order has no such description.
+		virtual Matrix matrix(size_t /*n*/) const { return {}; }
 	private:
 		//Compares vectors of degrees, returning true if the first argument is less than the second
-		virtual bool compare(const std::vector<int>& lDegrees, const std::vector<int>& rDegrees) const = 0;
+		virtual bool compare(const Degrees& lDegrees, const Degrees& rDegrees) const = 0;
 	};
 
 private:
 	//The degree of each variable. Never has trailing zeroes.
 	//if the first three variables are x,y,z, x*z^3 corresponds to {1,0,3}
-	std::vector<int> mDegrees;
+	Degrees mDegrees;
 };
@@ -6,15 +6,15 @@ via their toString methods, allowing them to keep their data as private as possi
 
 Because C++ requires templates for generic iterators (as opposed to Java's dynamic 
 polymorphism through List or Iterator), passing a collection of data to a virtual method in a 
-container-agnostic way is not truly possible. Thus, powerProductString takes a vector,
-rather than an iterator range per the convention in this project. I'm not happy about this,
-but the workaround was too ugly and inefficient to be worth it. PowerProduct::TermOrder::compare
-has a similar issue, but at least that's private virtual
+container-agnostic way is not truly possible. Thus, powerProductString takes a range of
+pointers to the degrees, which are contiguous, so the printer needn't know how PowerProduct
+stores or allocates them. PowerProduct::TermOrder::compare has a similar issue, but at least
+that's private virtual
 */
 
 #pragma once
+#include <iosfwd>
 #include <string>
-#include <vector>
 class PowerProduct; //forward declaration to avoid include loop
 
 // Used by PowerProduct and Polynomial to produce string representations.
@@ -30,7 +30,18 @@ public:
 	virtual std::string print() = 0;
 
 	/// Returns a string representation of a power product with the
-	/// given degrees.
-	virtual std::string powerProductString(const std::vector<int>& degrees) = 0;
+	/// degrees in the range [first,last).
+	virtual std::string powerProductString(const int* first, const int* last) = 0;
+
+	// Writes a term directly to out, with the sign joining it to the terms before it unless it
+	// is the leading term.
+	virtual void writeTerm(std::ostream& out, const Coef& coef, const PowerProduct& powerProduct, bool leading) = 0;
+
+	// Writes the zero polynomial to out.
+	virtual void writeZero(std::ostream& out) = 0;
+
+	// Writes the power product with the degrees in the range [first,last) to out, as the
+	// variables alone, with nothing for the power product 1.
+	virtual void writePowerProduct(std::ostream& out, const int* first, const int* last) = 0;
 };
 
@@ -0,0 +1,74 @@
+/*
+Notes: The counts are updated by the computation at the same safe points its Budget is
+checked, so they are current to within one batch of critical pairs. Each is read on its
+own; the counts read together may come from neighbouring updates.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// The progress of a computation of a Grobner basis, reported by the computation and read
+// from any thread.
+class Progress final
+{
+public:
+	// What the computation is doing.
+	enum Phase
+	{
+		Idle, // not started
+		Computing, // Buchberger's algorithm
+		Minimizing, // discarding redundant elements
+		Reducing, // reducing the tails of the elements
+		Converting // converting a basis to a new term order
+	};
+
+	Progress() = default;
+	Progress(const Progress&) = delete;
+	Progress& operator=(const Progress&) = delete;
+
+	// Returns the name of phase, such as "computing".
+	static const char* name(Phase phase)
+	{
+		switch (phase)
+		{
+		case Computing:
+			return "computing";
+		case Minimizing:
+			return "minimizing";
+		case Reducing:
+			return "reducing";
+		case Converting:
+			return "converting";
+		default:
+			return "idle";
+		}
+	}
+
+	// Returns the phase of the computation.
+	Phase phase() const { return mPhase.load(std::memory_order_relaxed); }
+
+	// Returns the critical pairs still queued, and reduced so far, by Buchberger's algorithm.
+	size_t pairsLeft() const { return mPairsLeft.load(std::memory_order_relaxed); }
+	size_t pairsReduced() const { return mPairsReduced.load(std::memory_order_relaxed); }
+
+	// Returns the elements in the basis so far.
+	size_t basisSize() const { return mBasisSize.load(std::memory_order_relaxed); }
+
+	// Called by the computation as it starts each phase.
+	void setPhase(Phase phase) { mPhase.store(phase, std::memory_order_relaxed); }
+
+	// Called by the computation with its counts.
+	void update(size_t pairsLeft, size_t pairsReduced, size_t basisSize)
+	{
+		mPairsLeft.store(pairsLeft, std::memory_order_relaxed);
+		mPairsReduced.store(pairsReduced, std::memory_order_relaxed);
+		mBasisSize.store(basisSize, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<Phase> mPhase{ Idle };
+	std::atomic<size_t> mPairsLeft{ 0 };
+	std::atomic<size_t> mPairsReduced{ 0 };
+	std::atomic<size_t> mBasisSize{ 0 };
+};
@@ -25,6 +25,12 @@ public:
 		reduce();
 	}
 
+	// Returns the numerator, in lowest terms.
+	Integer numerator() const { return mNumerator; }
+
+	// Returns the denominator, in lowest terms; always positive.
+	Integer denominator() const { return mDenominator; }
+
 	friend bool operator==(const Rational& left, const Rational& right)
 	{
 		return left.mNumerator == right.mNumerator && left.mDenominator == right.mDenominator;
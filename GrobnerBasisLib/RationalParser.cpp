@@ -1,85 +1,448 @@
 #include "RationalParser.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 
-//regexes
+namespace
+{
+	bool isLetter(char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0; }
+	bool isDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
 
-//matches 25, 3/11, etc.
-const std::string number{ "[0-9]+(\\/[0-9]+)?" };
-//matches x, y, a1, Name123, etc.
-const std::string name{ "[a-zA-Z]+[0-9]*" };
-//matches x, x^2, a1^3, etc.
-const std::string power{ name + "(\\^[0-9]+)?" };
-//matches 2/3*x^2*y^3, x1^2*x2*x3^5, etc.
-const std::string term{ "(" + number + "|" + power + ")(\\*" + power + ")*" };
-//matches -3*x+x^2*y, x-5y, etc.
-const std::string poly{ "\\-?" + term + "([\\+\\-]" + term + ")*" };
+	//true for 1 or more letters followed by 0 or more digits, such as x, y, a1, Name123
+	bool isName(std::string_view s)
+	{
+		auto digits = std::find_if(s.begin(), s.end(), isDigit);
+		return digits != s.begin() && std::all_of(s.begin(), digits, isLetter) && std::all_of(digits, s.end(), isDigit);
+	}
 
-Polynomial<Rational<int>> RationalParser::parse(const std::string& input) const
+	//a degree, checked to fit in an int
+	int checkedDegree(long long degree)
+	{
+		if (degree > std::numeric_limits<int>::max())
+			throw std::overflow_error("exponent too large");
+		return static_cast<int>(degree);
+	}
+
+	//base^exponent, by repeated squaring
+	Rational<int> power(Rational<int> base, int exponent)
+	{
+		Rational<int> result = 1;
+		for (; exponent > 0; exponent /= 2, base *= base)
+			if (exponent % 2 == 1)
+				result *= base;
+		return result;
+	}
+}
+
+class RationalParser::Cursor
+{
+public:
+	explicit Cursor(const std::string& input) : mInput{ input } {}
+
+	// Skips whitespace, then returns true if the input is used up.
+	bool atEnd()
+	{
+		while (mPosition < mInput.size() && std::isspace(static_cast<unsigned char>(mInput[mPosition])))
+			++mPosition;
+		return mPosition == mInput.size();
+	}
+
+	// Returns the next character after any whitespace, or '\0' at the end.
+	char peek() { return atEnd() ? '\0' : mInput[mPosition]; }
+
+	// Consumes c if it is next.
+	bool accept(char c)
+	{
+		if (peek() != c)
+			return false;
+		++mPosition;
+		return true;
+	}
+
+	// Consumes and returns the run of characters for which f is true, with no whitespace skipped.
+	template <typename Function>
+	std::string_view take(Function f)
+	{
+		size_t first = mPosition;
+		while (mPosition < mInput.size() && f(mInput[mPosition]))
+			++mPosition;
+		return std::string_view(mInput).substr(first, mPosition - first);
+	}
+
+	// Consumes an unsigned integer that fits in an int.
+	int integer()
+	{
+		size_t first = mPosition;
+		int value = 0;
+		for (char digit : take(isDigit))
+		{
+			if (value > (std::numeric_limits<int>::max() - (digit - '0')) / 10)
+				fail("number too large", first);
+			value = value * 10 + (digit - '0');
+		}
+		if (mPosition == first)
+			fail("expected a number");
+		return value;
+	}
+
+	size_t position() const { return mPosition; }
+
+	// Counts an open parenthesis, failing if they are nested too deeply to parse recursively.
+	void enter()
+	{
+		if (++mDepth > maxDepth)
+			fail("parentheses nested too deeply", mPosition - 1);
+	}
+
+	// Counts a close parenthesis.
+	void leave() { --mDepth; }
+
+	// Throws a ParseException for an error at position, by default the next character.
+	[[noreturn]] void fail(const std::string& message, size_t position = std::string::npos)
+	{
+		if (position == std::string::npos)
+		{
+			atEnd();
+			position = mPosition;
+		}
+		throw ParseException(message + " at column " + std::to_string(position + 1) + ": " + mInput, position);
+	}
+
+private:
+	static constexpr size_t maxDepth = 1000;
+
+	const std::string& mInput;
+	size_t mPosition{ 0 };
+	size_t mDepth{ 0 };
+};
+
+class RationalParser::Plan
+{
+public:
+	explicit Plan(size_t variables) : mVariables{ variables } {}
+
+	// Each of these adds a step and returns its index, or the index of an equal step already
+	// added. Steps only refer to steps added before them. Throws std::overflow_error if a
+	// degree of the result could exceed the range of int.
+
+	// The monomial coef times the variables raised to degrees.
+	size_t monomial(const Rational<int>& coef, std::vector<int> degrees);
+
+	// The constant c.
+	size_t constant(const Rational<int>& c) { return monomial(c, std::vector<int>(mVariables)); }
+
+	// The nth variable.
+	size_t variable(size_t n)
+	{
+		std::vector<int> degrees(mVariables);
+		degrees[n] = 1;
+		return monomial(1, std::move(degrees));
+	}
+
+	// The sum of steps.
+	size_t sum(std::vector<size_t> steps);
+
+	// The product of steps left and right.
+	size_t product(size_t left, size_t right);
+
+	// Step base raised to exponent.
+	size_t power(size_t base, int exponent);
+
+	// Expands step root, and the steps it uses, into a polynomial.
+	Polynomial<Rational<int>> evaluate(size_t root) const;
+
+private:
+	enum class Kind { Monomial, Sum, Product, Power };
+
+	struct Step
+	{
+		Kind kind;
+		std::vector<int> degrees; //a monomial's degrees; otherwise a bound on the degree of each variable
+		Rational<int> coef; //monomials only
+		std::vector<size_t> operands; //not monomials
+		int exponent{ 0 }; //powers only
+	};
+
+	size_t mVariables;
+	std::vector<Step> mSteps;
+	std::map<std::vector<long long>, size_t> mIndex; //each step's index, by kind, operands and values
+
+	//add step, or find an equal one, under key
+	size_t add(std::vector<long long> key, Step step);
+
+	bool isMonomial(size_t step) const { return mSteps[step].kind == Kind::Monomial; }
+};
+
+size_t RationalParser::Plan::add(std::vector<long long> key, Step step)
+{
+	auto [it, inserted] = mIndex.emplace(std::move(key), mSteps.size());
+	if (inserted)
+		mSteps.push_back(std::move(step));
+	return it->second;
+}
+
+size_t RationalParser::Plan::monomial(const Rational<int>& coef, std::vector<int> degrees)
+{
+	if (coef == 0)
+		std::fill(degrees.begin(), degrees.end(), 0);
+	std::vector<long long> key{ static_cast<long long>(Kind::Monomial), coef.numerator(), coef.denominator() };
+	key.insert(key.end(), degrees.begin(), degrees.end());
+	return add(std::move(key), Step{ Kind::Monomial, std::move(degrees), coef, {} });
+}
+
+size_t RationalParser::Plan::sum(std::vector<size_t> steps)
+{
+	if (steps.size() == 1)
+		return steps.front();
+
+	//sums of the same steps in any order are equal
+	std::sort(steps.begin(), steps.end());
+	std::vector<int> degrees(mVariables);
+	for (size_t step : steps)
+		for (size_t i = 0; i < mVariables; ++i)
+			degrees[i] = std::max(degrees[i], mSteps[step].degrees[i]);
+
+	std::vector<long long> key{ static_cast<long long>(Kind::Sum) };
+	key.insert(key.end(), steps.begin(), steps.end());
+	return add(std::move(key), Step{ Kind::Sum, std::move(degrees), 0, std::move(steps) });
+}
+
+size_t RationalParser::Plan::product(size_t left, size_t right)
+{
+	if (isMonomial(right) && !isMonomial(left))
+		std::swap(left, right);
+	std::vector<int> degrees(mVariables);
+	for (size_t i = 0; i < mVariables; ++i)
+		degrees[i] = checkedDegree(static_cast<long long>(mSteps[left].degrees[i]) + mSteps[right].degrees[i]);
+
+	if (isMonomial(left))
+	{
+		const Rational<int>& coef = mSteps[left].coef;
+		if (isMonomial(right)) //fold into one monomial
+			return monomial(coef * mSteps[right].coef, std::move(degrees));
+		if (coef == 0)
+			return left;
+		if (coef == 1 && std::all_of(mSteps[left].degrees.begin(), mSteps[left].degrees.end(), [](int d) { return d == 0; }))
+			return right;
+	}
+	else if (right < left) //products are commutative
+		std::swap(left, right);
+
+	return add({ static_cast<long long>(Kind::Product), static_cast<long long>(left), static_cast<long long>(right) },
+		Step{ Kind::Product, std::move(degrees), 0, { left, right } });
+}
+
+size_t RationalParser::Plan::power(size_t base, int exponent)
 {
-	std::string strippedInput = std::regex_replace(input, std::regex{ "\\s" }, ""); //strip whitespace
-	if (!std::regex_match(strippedInput, std::regex(poly))) //check that the format is valid
-		throw ParseException("invalid input format: " + input);
+	if (exponent == 0)
+		return constant(1);
+	if (exponent == 1)
+		return base;
+	std::vector<int> degrees(mVariables);
+	for (size_t i = 0; i < mVariables; ++i)
+		degrees[i] = checkedDegree(static_cast<long long>(mSteps[base].degrees[i]) * exponent);
 
-	Polynomial<Rational<int>> result;
+	if (isMonomial(base))
+		return monomial(::power(mSteps[base].coef, exponent), std::move(degrees));
+	return add({ static_cast<long long>(Kind::Power), static_cast<long long>(base), exponent },
+		Step{ Kind::Power, std::move(degrees), 0, { base }, exponent });
+}
+
+Polynomial<Rational<int>> RationalParser::Plan::evaluate(size_t root) const
+{
+	using Term = std::pair<PowerProduct, Rational<int>>;
+
+	//count the uses of each step that root depends on, so each result is freed after its last use
+	std::vector<size_t> uses(root + 1);
+	uses[root] = 1;
+	for (size_t i = root + 1; i-- > 0;)
+		if (uses[i] != 0)
+			for (size_t operand : mSteps[i].operands)
+				++uses[operand];
+
+	//monomials are used where they are needed, as terms, so only other steps have results
+	auto termOf = [&](size_t monomial) { return Term{ PowerProduct(mSteps[monomial].degrees), mSteps[monomial].coef }; };
+	if (isMonomial(root))
+	{
+		Term term = termOf(root);
+		return Polynomial<Rational<int>>(&term, &term + 1);
+	}
 
-	//beginning and end of each term
-	size_t first = 0, last = strippedInput.find_first_of("+-", 1);
-	while (first < strippedInput.size())
+	std::vector<Polynomial<Rational<int>>> results(root + 1);
+	for (size_t i = 0; i <= root; ++i)
 	{
-		if (last == std::string::npos) last = strippedInput.size(); //this is the final term
+		const Step& step = mSteps[i];
+		if (uses[i] == 0 || step.kind == Kind::Monomial)
+			continue;
+
+		switch (step.kind)
+		{
+		case Kind::Sum:
+		{
+			//gather every term and merge them once
+			std::vector<Term> terms;
+			for (size_t operand : step.operands)
+			{
+				if (isMonomial(operand))
+					terms.push_back(termOf(operand));
+				else
+					terms.insert(terms.end(), results[operand].begin(), results[operand].end());
+			}
+			results[i] = Polynomial<Rational<int>>(terms.begin(), terms.end());
+			break;
+		}
+		case Kind::Product:
+		{
+			//product() puts a monomial operand on the left
+			const auto& right = results[step.operands[1]];
+			if (isMonomial(step.operands[0]) || results[step.operands[0]].size() == 1)
+			{
+				//multiplying by a monomial keeps the terms in order, so they need no sorting
+				auto [powerProduct, coef] = isMonomial(step.operands[0]) ? termOf(step.operands[0]) : Term(*results[step.operands[0]].begin());
+				std::vector<Term> terms;
+				terms.reserve(right.size());
+				for (const auto& [rightPower, rightCoef] : right)
+					terms.emplace_back(powerProduct * rightPower, coef * rightCoef);
+				results[i] = Polynomial<Rational<int>>(terms.begin(), terms.end());
+			}
+			else
+				results[i] = results[step.operands[0]] * right;
+			break;
+		}
+		case Kind::Power:
+			results[i] = results[step.operands[0]].pow(step.exponent);
+			break;
+		default:
+			break;
+		}
 
-		if (strippedInput[first] == '+') //addition
-			result += parseTerm(strippedInput.substr(first + 1, last - (first + 1)));
-		else if (strippedInput[first] == '-') //subtraction
-			result -= parseTerm(strippedInput.substr(first + 1, last - (first + 1)));
-		else //first term, positive
-			result += parseTerm(strippedInput.substr(first, last - first));
-		first = last;
-		last = strippedInput.find_first_of("+-", first + 1); //next term
+		for (size_t operand : step.operands)
+			if (--uses[operand] == 0)
+				results[operand] = Polynomial<Rational<int>>();
 	}
+	return std::move(results[root]);
+}
 
-	return result;
+Polynomial<Rational<int>> RationalParser::parse(const std::string& input) const
+{
+	//parse the whole input into a plan, then expand it once
+	Cursor cursor(input);
+	Plan plan(mVarNames.size());
+	size_t root = parseSum(cursor, plan);
+	if (!cursor.atEnd())
+		cursor.fail(cursor.peek() == ')' ? "unmatched )" : "expected an operator");
+	return plan.evaluate(root);
 }
 
 void RationalParser::verifyNames() const
 {
 	for (const auto& var : mVarNames)
 	{
-		if (!std::regex_match(var, std::regex{ name }))
+		if (!isName(var))
 			throw ParseException("invalid variable name " + var);
 		if (std::count(mVarNames.begin(), mVarNames.end(), var) > 1)
 			throw ParseException("duplicate variable name " + var);
 	}
 }
 
-Polynomial<Rational<int>> RationalParser::parseTerm(const std::string& termString) const
+size_t RationalParser::parseSum(Cursor& cursor, Plan& plan) const
 {
-	Polynomial<Rational<int>> term = 1;
-	std::stringstream ss(termString);
-	if (std::isdigit(ss.peek())) //if there's a coefficient
+	std::vector<size_t> terms;
+	bool negative = cursor.accept('-');
+	while (true)
 	{
-		Rational<int> coef;
-		ss >> coef;
-		term *= coef;
-		ss.ignore(); //skip the *
+		size_t term = parseProduct(cursor, plan);
+		terms.push_back(negative ? plan.product(plan.constant(-1), term) : term);
+
+		if (cursor.accept('+'))
+			negative = false;
+		else if (cursor.accept('-'))
+			negative = true;
+		else
+			return plan.sum(std::move(terms));
 	}
+}
 
-	//split the rest of the input at each '*' to get each "power" such as x^2 or a1^3
-	for (std::string powerString; std::getline(ss, powerString, '*'); )
+size_t RationalParser::parseProduct(Cursor& cursor, Plan& plan) const
+{
+	size_t product = parseFactor(cursor, plan);
+	while (true)
 	{
-		auto caretPos = powerString.find('^'); //find the caret, if any
-		//find the position of the variable name in the list
-		auto varPos = std::find(mVarNames.begin(), mVarNames.end(), powerString.substr(0, caretPos));
-		if (varPos == mVarNames.end()) //didn't find it
-			throw ParseException("unknown variable name " + powerString.substr(0, caretPos));
+		cursor.atEnd(); //skip whitespace, to point at the operator
+		size_t first = cursor.position();
+		try
+		{
+			if (cursor.accept('*'))
+				product = plan.product(product, parseFactor(cursor, plan));
+			else if (cursor.accept('/')) //only by a number, such as 1/2 or (x+y)/3
+			{
+				cursor.atEnd();
+				size_t denominator = cursor.position();
+				int value = cursor.integer();
+				if (value == 0)
+					cursor.fail("zero denominator", denominator);
+				product = plan.product(product, plan.constant(Rational<int>(1, value)));
+			}
+			else
+				return product;
+		}
+		catch (std::overflow_error&)
+		{
+			cursor.fail("exponent too large", first);
+		}
+	}
+}
 
-		int p = 1; //the power
-		if (caretPos != std::string::npos) //if there was an exponent
-			p = std::stoi(powerString.substr(caretPos + 1)); //parse it
+size_t RationalParser::parseFactor(Cursor& cursor, Plan& plan) const
+{
+	size_t base;
+	if (cursor.accept('('))
+	{
+		cursor.enter();
+		base = parseSum(cursor, plan);
+		if (!cursor.accept(')'))
+			cursor.fail("expected )");
+		cursor.leave();
+	}
+	else if (isDigit(cursor.peek()))
+		base = plan.constant(cursor.integer());
+	else if (isLetter(cursor.peek()))
+		base = plan.variable(parseVariable(cursor));
+	else
+		cursor.fail("expected a number, variable or (");
 
-		//update the term
-		auto varIndex = std::distance(mVarNames.begin(), varPos);
-		term *= PowerProduct(varIndex).pow(p);
+	if (cursor.accept('^'))
+	{
+		cursor.atEnd();
+		size_t first = cursor.position();
+		int exponent = cursor.integer();
+		try
+		{
+			base = plan.power(base, exponent);
+		}
+		catch (std::overflow_error&)
+		{
+			cursor.fail("exponent too large", first);
+		}
 	}
+	return base;
+}
 
-	return term;
-}
\ No newline at end of file
+size_t RationalParser::parseVariable(Cursor& cursor) const
+{
+	if (!isLetter(cursor.peek()))
+		cursor.fail("expected a variable");
+	size_t first = cursor.position();
+	std::string_view letters = cursor.take(isLetter);
+	std::string_view digits = cursor.take(isDigit);
+	std::string_view name(letters.data(), letters.size() + digits.size());
+
+	auto var = std::find(mVarNames.begin(), mVarNames.end(), name);
+	if (var == mVarNames.end())
+		cursor.fail("unknown variable name " + std::string(name), first);
+	return var - mVarNames.begin();
+}
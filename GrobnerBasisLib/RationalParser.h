@@ -2,8 +2,10 @@
 Author: Elias Sink
 Date: 5/11/2022
 Notes: If term ordering were decoupled from Polynomial, it would be decoupled from here as well.
-This parser is pretty simplistic; ideally it would be able to handle inputs like (x+y)^2, but
-that turns out to be pretty hard.
+Expressions such as (x+y)^2 are compiled to a plan before anything is expanded. Equal
+subexpressions share one step of the plan, products and powers of monomials are folded as they
+are parsed, and the remaining steps expand straight into terms, so a generator given in factored
+form costs about as much as its expanded result, not its expanded text.
 */
 
 
@@ -11,12 +13,11 @@ that turns out to be pretty hard.
 #include "Parser.h"
 #include "Polynomial.h"
 #include "Rational.h"
-#include <regex>
 #include <vector>
-#include <sstream>
-#include <algorithm>
+#include <string>
 
-// Parses polynomials with rational coefficients in standard form.
+// Parses polynomials with rational coefficients, written as sums, products, and powers of
+// numbers, variables, and parenthesized expressions, such as 1/2*x^2 - 3*(x + y)^2*z.
 class RationalParser final :
     public Parser<Polynomial<Rational<int>>>
 {
@@ -38,7 +39,10 @@ public:
 		verifyNames();
 	}
 
-    // Parse a polynomial from the input string. Throws Parser<>::ParseException if an error occurs.
+    // Parse a polynomial from the input string. Throws Parser<>::ParseException if an error occurs,
+    // with the position of the first character that could not be parsed.
+    // Whitespace may appear between, but not within, numbers, names, and operators.
+    // Exponents are nonnegative integers, and only integers may follow '/'.
     Polynomial<Rational<int>> parse(const std::string& input) const override;
 
 private:
@@ -49,6 +53,21 @@ private:
 	//check that the names are valid: 1 or more letters followed by 0 or more numbers
 	void verifyNames() const;
 
-	//parse a single term
-	Polynomial<Rational<int>> parseTerm(const std::string& termString) const;
+	//the input and the position reached in it
+	class Cursor;
+
+	//the steps that expand a parsed expression
+	class Plan;
+
+	//parse a sum of products, such as 2/3*x^2*y - (x+y)^2, returning its step in plan
+	size_t parseSum(Cursor& cursor, Plan& plan) const;
+
+	//parse a product of factors, such as 2/3*x^2*(x+y)
+	size_t parseProduct(Cursor& cursor, Plan& plan) const;
+
+	//parse a number, variable or parenthesized sum, with an optional exponent
+	size_t parseFactor(Cursor& cursor, Plan& plan) const;
+
+	//parse a variable name and return its index
+	size_t parseVariable(Cursor& cursor) const;
 };
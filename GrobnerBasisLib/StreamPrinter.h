@@ -6,12 +6,14 @@ Notes: See StreamPrinterUML.txt for Unified Modeling Language description
 
 #pragma once
 #include "Printer.h"
+#include "PowerProduct.h"
 #include <initializer_list>
+#include <ostream>
 #include <sstream>
 #include <vector>
-#include <regex>
 
-// Prints polynomials using a std::ostringstream. Coef must have an appropriate insertion operator.
+// Prints polynomials using a std::ostringstream, or writes them directly to any std::ostream.
+// Coef must have an appropriate insertion operator, and compare with Coef(0), Coef(1) and Coef(-1).
 // Supports customizable variable names.
 template<typename Coef>
 class StreamPrinter final :
@@ -34,11 +36,8 @@ public:
     // Add a term to the buffer.
     void addTerm(const Coef& coef, const PowerProduct& powerProduct) override
     {
-        if (!isZero)
-            mStringStream << " + "; 
-        else
-            isZero = false;
-        mStringStream << coef << powerProduct.toString(*this);
+        writeTerm(mStringStream, coef, powerProduct, isZero);
+        isZero = false;
     }
    
     // Return a polynomial string from the terms in the buffer, and clear the buffer.
@@ -49,34 +48,66 @@ public:
         std::string output = mStringStream.str();
         mStringStream.str(""); //clear buffer
         isZero = true;
-
-        //replaces "x + -y" with "x - y"
-        output = std::regex_replace(output, std::regex("\\+ \\-"), "- ");
-        //replaces "x + 1*y" with "x + y"
-        output = std::regex_replace(output, std::regex(" 1\\*"), " ");
-        //replaces "1*x + y" with "x + y"
-        output = std::regex_replace(output, std::regex("^1\\*"), "");
-        //replaces "-1*x + y" with "-x + y"
-        output = std::regex_replace(output, std::regex("^\\-1\\*"), "-");
         return output;
     }
 
     // Returns a string representation of a power product with the
-    // given degrees.
-    std::string powerProductString(const std::vector<int>& degrees) override
+    // degrees in the range [first,last).
+    std::string powerProductString(const int* first, const int* last) override
     {
         std::ostringstream ss;
-        for (size_t n = 0; n < degrees.size(); ++n)
+        for (size_t n = 0; first + n != last; ++n)
         {
-            if (degrees[n] == 0)
+            if (first[n] == 0)
                 continue;
-            ss << '*' << var(n); //nth variable name
-            if (degrees[n] > 1)
-                ss << '^' << degrees[n];
+            ss << '*';
+            writeVariable(ss, n, first[n]);
         }
         return ss.str();
     }
 
+    // Writes a term to out, such as "-3/2*x^2" if leading or " + y" otherwise. Signs and
+    // coefficients of 1 are settled here, so the output needs no fixing up afterwards.
+    void writeTerm(std::ostream& out, const Coef& coef, const PowerProduct& powerProduct, bool leading) override
+    {
+        bool negative = coef < Coef(0);
+        if (!leading)
+            out << (negative ? " - " : " + ");
+        else if (negative)
+            out << '-';
+
+        //the coefficient is left out before variables when it is 1 or -1
+        bool constant = powerProduct.variables() == 0;
+        if (constant || coef != Coef(negative ? -1 : 1))
+        {
+            if (negative)
+                out << -coef;
+            else
+                out << coef;
+            if (!constant)
+                out << '*';
+        }
+        powerProduct.print(out, *this);
+    }
+
+    // Writes "0".
+    void writeZero(std::ostream& out) override { out << '0'; }
+
+    // Writes a power product, such as "x*y^2", with nothing for 1.
+    void writePowerProduct(std::ostream& out, const int* first, const int* last) override
+    {
+        bool leading = true;
+        for (size_t n = 0; first + n != last; ++n)
+        {
+            if (first[n] == 0)
+                continue;
+            if (!leading)
+                out << '*';
+            leading = false;
+            writeVariable(out, n, first[n]);
+        }
+    }
+
 private:
     //the stringstream for buffering terms
     std::ostringstream mStringStream;
@@ -85,14 +116,15 @@ private:
     //true of there are no terms buffered
     bool isZero = true;
     
-    //returns the nth variable name
-    std::string var(size_t n) const
+    //writes the nth variable name, with its degree if it is not 1
+    void writeVariable(std::ostream& out, size_t n, int degree) const
     {
         if (n < mVarNames.size()) 
-            return mVarNames[n];//custom name
-        std::ostringstream ss;
-        ss << 'x' << (n + 1);
-        return ss.str(); //default name
+            out << mVarNames[n]; //custom name
+        else
+            out << 'x' << (n + 1); //default name
+        if (degree > 1)
+            out << '^' << degree;
     }
 };
 
@@ -0,0 +1,94 @@
+#include "ThreadPool.h"
+
+namespace
+{
+	//the pool the current thread works for, and its queue there
+	thread_local const ThreadPool* currentPool = nullptr;
+	thread_local size_t currentQueue = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+	if (threadCount == 0)
+		threadCount = 1;
+	for (unsigned i = 0; i < threadCount; ++i)
+		mQueues.push_back(std::make_unique<Queue>());
+	for (unsigned i = 0; i < threadCount; ++i)
+		mWorkers.emplace_back([this, i]() { work(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+		mStop = true;
+	}
+	mWake.notify_all();
+	for (auto& worker : mWorkers)
+		worker.join();
+}
+
+void ThreadPool::push(Task task)
+{
+	{
+		//counted first (under the lock a sleeping worker checks) so the count never lags the deques
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+		++mQueued;
+	}
+	Queue& queue = *mQueues[homeQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+	mWake.notify_one();
+}
+
+bool ThreadPool::runOne(size_t preferred)
+{
+	Task task;
+	for (size_t n = 0; n < mQueues.size() && !task; ++n)
+	{
+		size_t index = (preferred + n) % mQueues.size();
+		Queue& queue = *mQueues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty())
+			continue;
+		if (index == preferred) //own work: newest first, while it is still hot in cache
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else //stolen work: oldest first, which tends to be the largest
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+	}
+	if (!task)
+		return false;
+	--mQueued;
+	task();
+	return true;
+}
+
+void ThreadPool::work(size_t index)
+{
+	currentPool = this;
+	currentQueue = index;
+	while (true)
+	{
+		if (runOne(index))
+			continue;
+		std::unique_lock<std::mutex> lock(mSleepMutex);
+		mWake.wait(lock, [&]() { return mStop || mQueued > 0; });
+		if (mStop && mQueued == 0)
+			return;
+	}
+}
+
+size_t ThreadPool::homeQueue() const
+{
+	if (currentPool == this)
+		return currentQueue;
+	return mNextQueue++ % mQueues.size();
+}
@@ -0,0 +1,136 @@
+/*
+Notes: Each worker owns a deque of tasks. A worker takes new work from the back of its
+own deque and, when that runs dry, steals from the front of the others', so a burst of
+tasks submitted from one thread still spreads over every worker. Threads waiting on
+a forEach help run tasks instead of blocking, which keeps nested use from deadlocking.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed-size pool of worker threads with work stealing.
+class ThreadPool final
+{
+public:
+	// Starts threadCount workers (at least one).
+	explicit ThreadPool(unsigned threadCount);
+
+	// Finishes the queued tasks and joins the workers.
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Returns the number of worker threads.
+	unsigned size() const { return static_cast<unsigned>(mWorkers.size()); }
+
+	// Queues f() to run on a worker, returning a future for its result.
+	template <typename Function>
+	auto submit(Function f) -> std::future<decltype(f())>
+	{
+		using Result = decltype(f());
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+		std::future<Result> result = task->get_future();
+		push([task]() { (*task)(); });
+		return result;
+	}
+
+	// Calls f(i) for each i in [0,count) on the pool and waits for all of the calls.
+	// The calling thread runs tasks while it waits. If any call throws, the remaining
+	// indices are skipped and the first exception is rethrown.
+	template <typename Function>
+	void forEach(size_t count, Function f);
+
+private:
+	using Task = std::function<void()>;
+
+	//a worker's deque; the owner works from the back, thieves from the front
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> mQueues; //one per worker
+	std::vector<std::thread> mWorkers;
+	std::mutex mSleepMutex; //guards sleeping and mStop
+	std::condition_variable mWake; //signalled when work arrives or the pool stops
+	std::atomic<size_t> mQueued{ 0 }; //tasks pushed but not yet taken
+	mutable std::atomic<unsigned> mNextQueue{ 0 }; //round robin for pushes from outside the pool
+	bool mStop{ false };
+
+	//queue a task, on the current worker's own deque if called from a worker
+	void push(Task task);
+
+	//take a task, preferring the given queue, and run it; false if there was none
+	bool runOne(size_t preferred);
+
+	//the body of each worker thread
+	void work(size_t index);
+
+	//the queue the current thread should prefer
+	size_t homeQueue() const;
+};
+
+template <typename Function>
+void ThreadPool::forEach(size_t count, Function f)
+{
+	if (count == 0)
+		return;
+
+	//shared by the chunks; outlives this call only if a chunk is still finishing up
+	struct State
+	{
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> remaining{ 0 };
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+	auto state = std::make_shared<State>();
+
+	//a few chunks per worker, each of which keeps claiming indices until none are left
+	size_t chunks = std::min<size_t>(count, size() * 4);
+	state->remaining = chunks;
+	for (size_t c = 0; c < chunks; ++c)
+	{
+		push([state, count, &f]()
+		{
+			for (size_t i = state->next++; i < count; i = state->next++)
+			{
+				try
+				{
+					f(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					if (!state->error)
+						state->error = std::current_exception();
+					state->next = count; //stop handing out indices
+				}
+			}
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (--state->remaining == 0)
+				state->done.notify_all();
+		});
+	}
+
+	//help out until every chunk has been claimed, then wait for the stragglers
+	while (state->remaining > 0 && runOne(homeQueue()))
+		;
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->done.wait(lock, [&]() { return state->remaining == 0; });
+
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
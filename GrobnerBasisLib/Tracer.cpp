@@ -0,0 +1,54 @@
+#include "Tracer.h"
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+Tracer::Tracer(const std::filesystem::path& path)
+	: mPath{ path }, mOut{ path, std::ios::binary | std::ios::trunc }, mStart{ Clock::now() }
+{
+	if (!mOut)
+		throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+	mOut << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+}
+
+Tracer::~Tracer()
+{
+	mOut << "\n]}\n";
+}
+
+void Tracer::flush()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mOut.flush();
+}
+
+void Tracer::record(const char* name, Clock::time_point start, Clock::time_point end, const std::string& args)
+{
+	//microseconds, to the nanosecond
+	auto micros = [](Clock::duration d)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof buffer, "%.3f", std::chrono::duration<double, std::micro>(d).count());
+		return std::string(buffer);
+	};
+	std::string times = "\"ts\":" + micros(start - mStart) + ",\"dur\":" + micros(end - start);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto thread = mThreads.find(std::this_thread::get_id());
+	if (thread == mThreads.end())
+	{
+		//a metadata event names each thread the first time it is seen
+		thread = mThreads.emplace(std::this_thread::get_id(), static_cast<int>(mThreads.size()) + 1).first;
+		std::string tid = std::to_string(thread->second);
+		writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid
+			+ ",\"args\":{\"name\":\"thread " + tid + "\"}}");
+	}
+	writeEvent(std::string("{\"name\":\"") + name + "\",\"cat\":\"grobner\",\"ph\":\"X\"," + times
+		+ ",\"pid\":1,\"tid\":" + std::to_string(thread->second) + ",\"args\":{" + args + "}}");
+}
+
+void Tracer::writeEvent(const std::string& event)
+{
+	mOut << (mFirst ? "\n" : ",\n") << event;
+	mFirst = false;
+}
@@ -0,0 +1,103 @@
+/*
+Notes: Events are written in the Chrome trace event format, which chrome://tracing and
+Perfetto load directly: a JSON object whose traceEvents array holds one complete ("X")
+event per span, with times in microseconds. Each event is written as its span ends, so
+a long run does not hold its trace in memory, and the file is closed off by the destructor.
+*/
+
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+// Records timed spans of work, from any number of threads, to a trace file.
+class Tracer final
+{
+public:
+	// A span of work, recorded from construction to destruction. A span made with a null
+	// tracer records nothing and costs only the check.
+	class Span final
+	{
+	public:
+		// Starts a span named name, a string literal, if tracer is not null.
+		Span(Tracer* tracer, const char* name)
+			: mTracer{ tracer }, mName{ name }
+		{
+			if (mTracer)
+				mStart = Clock::now();
+		}
+
+		// Ends the span and records it.
+		~Span()
+		{
+			if (mTracer)
+				mTracer->record(mName, mStart, Clock::now(), mArgs);
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+		// Returns true if the span is being recorded, so attributes that cost something to
+		// find can be skipped when it is not.
+		explicit operator bool() const { return mTracer != nullptr; }
+
+		// Attaches an attribute, a number or bool, shown with the span. key is a string literal.
+		template <typename T>
+		Span& arg(const char* key, T value)
+		{
+			static_assert(std::is_arithmetic_v<T>, "attributes are numbers or bools");
+			if (!mTracer)
+				return *this;
+			mArgs += mArgs.empty() ? "\"" : ",\"";
+			mArgs += key;
+			mArgs += "\":";
+			if constexpr (std::is_same_v<T, bool>)
+				mArgs += value ? "true" : "false";
+			else
+				mArgs += std::to_string(value);
+			return *this;
+		}
+
+	private:
+		Tracer* mTracer;
+		const char* mName;
+		std::chrono::steady_clock::time_point mStart;
+		std::string mArgs; //the attributes as JSON members
+	};
+
+	// Creates or replaces the trace file at path. Throws std::system_error if it cannot be opened.
+	explicit Tracer(const std::filesystem::path& path);
+
+	// Finishes the trace file.
+	~Tracer();
+
+	Tracer(const Tracer&) = delete;
+	Tracer& operator=(const Tracer&) = delete;
+
+	// Returns the path of the trace file.
+	const std::filesystem::path& path() const { return mPath; }
+
+	// Writes the events recorded so far through to the file.
+	void flush();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	std::filesystem::path mPath;
+	std::ofstream mOut;
+	Clock::time_point mStart; //time zero of the trace
+	std::mutex mMutex; //guards the rest
+	bool mFirst{ true }; //no event written yet
+	std::unordered_map<std::thread::id, int> mThreads; //small ids for the threads seen, from 1
+
+	//write the event for a span that has ended
+	void record(const char* name, Clock::time_point start, Clock::time_point end, const std::string& args);
+
+	//write one event, given as a JSON object, to the array
+	void writeEvent(const std::string& event);
+};
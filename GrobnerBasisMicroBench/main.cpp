@@ -0,0 +1,436 @@
+/*
+Notes: Each benchmark is timed in samples of enough iterations to last at least the minimum
+sample time, so clock resolution and loop overhead do not matter. The median and the median
+absolute deviation of the samples are reported, as they are not thrown by the odd sample
+interrupted by the system. The operands cycle through a pool made before timing starts, so
+branch prediction and caching cannot settle on a single value.
+*/
+#include "../GrobnerBasisBench/Workloads.h"
+#include "Ideal.h"
+#include "CoefficientCodec.h"
+#include "LexTermOrder.h"
+#include "DegLexTermOrder.h"
+#include "DegRevLexTermOrder.h"
+#include "MatrixTermOrder.h"
+#include "RationalParser.h"
+#include "StreamPrinter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+const std::string usage =
+"Usage: GrobnerBasisMicroBench [options]\n"
+"Times the primitive operations of the library and writes the results as JSON.\n\n"
+"  --filter TEXT         run only benchmarks whose names contain one of the comma\n"
+"                        separated TEXTs\n"
+"  --list                list the benchmark names and exit\n"
+"  --samples N           samples per benchmark (default 21)\n"
+"  --min-time MS         minimum length of a sample in milliseconds (default 10)\n"
+"  --output FILE         write the JSON to FILE instead of standard output\n"
+"  --baseline FILE       compare with the results in FILE, written by an earlier run,\n"
+"                        and exit with status 3 if any benchmark got slower\n"
+"  --threshold PERCENT   smallest change reported by --baseline (default 5)\n";
+
+using Q = Rational<long long>;
+using P = Polynomial<Q>;
+
+// Runs the operation being timed the given number of times.
+using Runner = std::function<void(size_t iterations)>;
+
+// A benchmark: its name, the bytes each operation handles (0 if not meaningful), and a
+// function that prepares the operands and returns the runner.
+struct Benchmark
+{
+	std::string name;
+	std::function<Runner()> setup;
+	size_t bytes{ 0 };
+};
+
+// The statistics of a benchmark, in nanoseconds per operation.
+struct Measurement
+{
+	std::string name;
+	double medianNs{ 0 };
+	double madNs{ 0 };
+	double minNs{ 0 };
+	size_t iterations{ 0 }; //per sample
+	size_t bytes{ 0 };
+};
+
+//keep the compiler from discarding a result that is never used
+template <typename T>
+void keep(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static const void* volatile sink;
+	sink = &value;
+	_ReadWriteBarrier();
+#endif
+}
+
+//a power product of n variables with degrees in [0,maxDegree]
+PowerProduct randomPowerProduct(std::mt19937& generator, size_t n, int maxDegree)
+{
+	std::vector<int> degrees(n);
+	for (int& d : degrees)
+		d = static_cast<int>(generator() % (maxDegree + 1));
+	return PowerProduct(degrees);
+}
+
+//a rational with numerator and denominator of up to bits bits
+Q randomRational(std::mt19937& generator, int bits)
+{
+	long long mask = (1LL << bits) - 1;
+	long long numerator = static_cast<long long>(generator() & mask) - (mask >> 1);
+	long long denominator = static_cast<long long>(generator() & mask) + 1;
+	return Q(numerator, denominator);
+}
+
+//a polynomial in n variables of terms terms, with small coefficients
+P randomPolynomial(std::mt19937& generator, size_t n, size_t terms, int maxDegree)
+{
+	std::vector<std::pair<PowerProduct, Q>> pairs;
+	for (size_t t = 0; t < terms; ++t)
+		pairs.emplace_back(randomPowerProduct(generator, n, maxDegree), Q(static_cast<long long>(generator() % 19) - 9 + 10, 1));
+	return P(pairs.begin(), pairs.end());
+}
+
+//a runner applying f to successive pairs from a pool of count operands made by make;
+//count must be a power of 2, so wrapping around costs a mask rather than a division
+template <typename Make, typename Function>
+Runner cycle(size_t count, Make make, Function f)
+{
+	std::vector<decltype(make())> pool;
+	for (size_t i = 0; i < count; ++i)
+		pool.push_back(make());
+	return [pool = std::move(pool), f, mask = count - 1](size_t iterations)
+	{
+		for (size_t i = 0; i < iterations; ++i)
+			keep(f(pool[i & mask], pool[(i + 1) & mask]));
+	};
+}
+
+std::vector<Benchmark> benchmarks()
+{
+	std::vector<Benchmark> list;
+	auto add = [&](std::string name, std::function<Runner()> setup, size_t bytes = 0)
+	{
+		list.push_back({ std::move(name), std::move(setup), bytes });
+	};
+
+	for (size_t vars : { 4, 16, 64 })
+	{
+		std::string suffix = "/vars:" + std::to_string(vars);
+		auto powerProducts = [vars](auto f)
+		{
+			return [vars, f]()
+			{
+				std::mt19937 generator(vars);
+				return cycle(64, [&]() { return randomPowerProduct(generator, vars, 5); }, f);
+			};
+		};
+		add("PowerProduct/multiply" + suffix, powerProducts([](const PowerProduct& a, const PowerProduct& b) { return a * b; }));
+		add("PowerProduct/divide" + suffix, powerProducts([](const PowerProduct& a, const PowerProduct& b) { return a.lcm(b) / b; }));
+		add("PowerProduct/lcm" + suffix, powerProducts([](const PowerProduct& a, const PowerProduct& b) { return a.lcm(b); }));
+		add("PowerProduct/isDivisibleBy" + suffix, powerProducts([](const PowerProduct& a, const PowerProduct& b) { return a.isDivisibleBy(b); }));
+
+		//each order compares the same operands
+		std::vector<std::pair<std::string, std::shared_ptr<PowerProduct::TermOrder>>> orders{
+			{ "lex", std::make_shared<LexTermOrder>() },
+			{ "deglex", std::make_shared<DegLexTermOrder>() },
+			{ "degrevlex", std::make_shared<DegRevLexTermOrder>() },
+			{ "matrix", std::make_shared<MatrixTermOrder>(PowerProduct::TermOrder::Matrix{ std::vector<long long>(vars, 1), std::vector<long long>{ 2, 1 } }) } };
+		for (const auto& [orderName, order] : orders)
+			add("TermOrder/" + orderName + suffix, powerProducts([order = order](const PowerProduct& a, const PowerProduct& b) { return (*order)(a, b); }));
+	}
+
+	for (int bits : { 8, 24 })
+	{
+		std::string suffix = "/bits:" + std::to_string(bits);
+		auto rationals = [bits](auto f)
+		{
+			return [bits, f]()
+			{
+				std::mt19937 generator(bits);
+				return cycle(64, [&]() { return randomRational(generator, bits); }, f);
+			};
+		};
+		add("Rational/add" + suffix, rationals([](const Q& a, const Q& b) { return a + b; }));
+		add("Rational/multiply" + suffix, rationals([](const Q& a, const Q& b) { return a * b; }));
+		add("Rational/divide" + suffix, rationals([](const Q& a, const Q& b) { return b == 0 ? a : a / b; }));
+		add("Rational/normalize" + suffix, rationals([](const Q& a, const Q& b) { return Q(a.numerator() * b.denominator(), a.denominator() * b.denominator()); }));
+	}
+
+	for (size_t terms : { 4, 16, 64 })
+	{
+		std::string suffix = "/terms:" + std::to_string(terms);
+		auto polynomials = [terms](auto f, size_t poolTerms)
+		{
+			return [terms, f, poolTerms]()
+			{
+				std::mt19937 generator(static_cast<unsigned>(terms));
+				return cycle(16, [&]() { return randomPolynomial(generator, 4, poolTerms, 4); }, f);
+			};
+		};
+		add("Polynomial/add" + suffix, polynomials([](const P& a, const P& b) { return a + b; }, terms));
+		add("Polynomial/multiply" + suffix, polynomials([](const P& a, const P& b) { return a * b; }, terms));
+		add("Polynomial/leadingTerm" + suffix, polynomials([order = DegRevLexTermOrder()](const P& a, const P&) { return a.leadingTerm(order); }, terms));
+	}
+	for (size_t terms : { 2, 4, 8 })
+	{
+		add("Polynomial/pow4/terms:" + std::to_string(terms), [terms]()
+		{
+			std::mt19937 generator(static_cast<unsigned>(terms));
+			return cycle(16, [&]() { return randomPolynomial(generator, 4, terms, 2); }, [](const P& a, const P&) { return a.pow(4); });
+		});
+	}
+
+	//reduction by the degrevlex bases of small standard systems
+	std::vector<std::pair<std::string, int>> systems{ { "cyclic", 4 }, { "katsura", 2 }, { "eco", 4 } };
+	for (const auto& [family, size] : systems)
+	{
+		add("Ideal/reduce/" + family + "-" + std::to_string(size), [family = family, size = size]()
+		{
+			auto generators = Workloads::generate<Q>(family, size);
+			auto ideal = std::make_shared<Ideal<Q>>(generators.begin(), generators.end(), std::make_unique<DegRevLexTermOrder>());
+			size_t vars = size + (family == "katsura" ? 1 : 0);
+			std::mt19937 generator(1);
+			return cycle(16, [&]() { return randomPolynomial(generator, vars, 8, 3); },
+				[ideal](const P& p, const P&) { return ideal->reduce(p); });
+		});
+	}
+
+	//parsing and printing, by the length of the text
+	for (size_t terms : { 16, 256 })
+	{
+		std::mt19937 generator(static_cast<unsigned>(terms));
+		P polynomial = randomPolynomial(generator, 3, terms, 6);
+		StreamPrinter<Q> printer{ "x", "y", "z" };
+		std::string text = polynomial.toString(printer);
+		std::string suffix = "/terms:" + std::to_string(terms);
+		add("RationalParser/parse" + suffix, [text]()
+		{
+			auto parser = std::make_shared<RationalParser>(std::initializer_list<std::string>{ "x", "y", "z" });
+			return Runner([parser, text](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+					keep(parser->parse(text));
+			});
+		}, text.size());
+		add("StreamPrinter/print" + suffix, [polynomial]()
+		{
+			auto printer = std::make_shared<StreamPrinter<Q>>(std::initializer_list<std::string>{ "x", "y", "z" });
+			auto out = std::make_shared<std::ostringstream>();
+			return Runner([polynomial, printer, out](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+				{
+					out->str("");
+					polynomial.print(*out, *printer);
+					keep(*out);
+				}
+			});
+		}, text.size());
+	}
+	return list;
+}
+
+double median(std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	size_t middle = values.size() / 2;
+	return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+Measurement measure(const Benchmark& benchmark, size_t samples, double minSeconds)
+{
+	Runner run = benchmark.setup();
+	auto time = [&](size_t iterations)
+	{
+		auto start = std::chrono::steady_clock::now();
+		run(iterations);
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	//enough iterations for a sample to last minSeconds, which also warms up
+	size_t iterations = 1;
+	for (double seconds; (seconds = time(iterations)) < minSeconds;)
+		iterations = seconds <= 0 ? iterations * 10 : std::max(iterations * 2, static_cast<size_t>(iterations * 1.2 * minSeconds / seconds));
+
+	std::vector<double> times;
+	for (size_t s = 0; s < samples; ++s)
+		times.push_back(time(iterations) * 1e9 / iterations);
+	Measurement m{ benchmark.name };
+	m.medianNs = median(times);
+	std::vector<double> deviations;
+	for (double t : times)
+		deviations.push_back(std::abs(t - m.medianNs));
+	m.madNs = median(deviations);
+	m.minNs = *std::min_element(times.begin(), times.end());
+	m.iterations = iterations;
+	m.bytes = benchmark.bytes;
+	return m;
+}
+
+//writes one measurement per line, so that readBaseline can read it back without a JSON parser
+void writeMeasurement(std::ostream& out, const Measurement& m)
+{
+	out << "    { \"name\": \"" << m.name << "\", \"medianNs\": " << m.medianNs << ", \"madNs\": " << m.madNs
+		<< ", \"minNs\": " << m.minNs << ", \"iterations\": " << m.iterations;
+	if (m.bytes != 0)
+		out << ", \"megabytesPerSecond\": " << m.bytes * 1e3 / m.medianNs;
+	out << " }";
+}
+
+//the number after "key": in line, or -1
+double field(const std::string& line, const std::string& key)
+{
+	size_t at = line.find("\"" + key + "\": ");
+	return at == std::string::npos ? -1 : std::strtod(line.c_str() + at + key.size() + 4, nullptr);
+}
+
+//the measurements in a file written by writeMeasurement, by name
+std::map<std::string, Measurement> readBaseline(const std::string& fileName)
+{
+	std::ifstream file(fileName);
+	if (!file)
+		throw std::runtime_error("cannot open " + fileName);
+	std::map<std::string, Measurement> baseline;
+	for (std::string line; std::getline(file, line);)
+	{
+		size_t first = line.find("\"name\": \"");
+		if (first == std::string::npos)
+			continue;
+		first += 9;
+		Measurement m{ line.substr(first, line.find('"', first) - first) };
+		m.medianNs = field(line, "medianNs");
+		m.madNs = field(line, "madNs");
+		baseline[m.name] = m;
+	}
+	return baseline;
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> filters;
+	size_t samples = 21;
+	double minSeconds = 0.01;
+	std::string output, baselineFile;
+	double threshold = 5;
+	bool list = false;
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string option = argv[i];
+			if (option == "--help")
+			{
+				std::cout << usage;
+				return 0;
+			}
+			if (option == "--list")
+			{
+				list = true;
+				continue;
+			}
+			if (i + 1 == argc)
+				throw std::invalid_argument("missing value for " + option);
+			std::string value = argv[++i];
+			if (option == "--filter")
+			{
+				std::istringstream ss(value);
+				for (std::string item; std::getline(ss, item, ',');)
+					filters.push_back(item);
+			}
+			else if (option == "--samples")
+				samples = std::max(1, std::stoi(value));
+			else if (option == "--min-time")
+				minSeconds = std::stod(value) / 1000;
+			else if (option == "--output")
+				output = value;
+			else if (option == "--baseline")
+				baselineFile = value;
+			else if (option == "--threshold")
+				threshold = std::stod(value);
+			else
+				throw std::invalid_argument("unknown option " + option);
+		}
+	}
+	catch (std::exception& ex)
+	{
+		std::cerr << "Error: " << ex.what() << "\n\n" << usage;
+		return 2;
+	}
+
+	std::vector<Benchmark> selected;
+	for (auto& benchmark : benchmarks())
+		if (filters.empty() || std::any_of(filters.begin(), filters.end(),
+			[&](const std::string& filter) { return benchmark.name.find(filter) != std::string::npos; }))
+			selected.push_back(std::move(benchmark));
+	if (list)
+	{
+		for (const auto& benchmark : selected)
+			std::cout << benchmark.name << '\n';
+		return 0;
+	}
+
+	std::map<std::string, Measurement> baseline;
+	std::ofstream file;
+	try
+	{
+		if (!baselineFile.empty())
+			baseline = readBaseline(baselineFile);
+		if (!output.empty())
+		{
+			file.open(output);
+			if (!file)
+				throw std::runtime_error("cannot open " + output);
+		}
+	}
+	catch (std::exception& ex)
+	{
+		std::cerr << "Error: " << ex.what() << "\n";
+		return 1;
+	}
+	std::ostream& out = output.empty() ? std::cout : file;
+
+	out << "{\n  \"samples\": " << samples << ", \"minSampleMs\": " << minSeconds * 1000 << ",\n  \"results\": [\n";
+	bool slower = false;
+	for (size_t i = 0; i < selected.size(); ++i)
+	{
+		Measurement m = measure(selected[i], samples, minSeconds);
+		writeMeasurement(out, m);
+		out << (i + 1 < selected.size() ? ",\n" : "\n");
+		out.flush();
+
+		//a change counts if it is past the threshold and well outside the noise of both runs
+		std::cerr << m.name << ": " << m.medianNs << " ns +- " << m.madNs;
+		auto base = baseline.find(m.name);
+		if (base != baseline.end() && base->second.medianNs > 0)
+		{
+			double change = (m.medianNs / base->second.medianNs - 1) * 100;
+			bool significant = std::abs(change) >= threshold
+				&& std::abs(m.medianNs - base->second.medianNs) > 3 * std::max(m.madNs, base->second.madNs);
+			std::cerr << " (baseline " << base->second.medianNs << " ns, " << (change >= 0 ? "+" : "") << change << "%"
+				<< (significant ? (change > 0 ? ", slower" : ", faster") : "") << ")";
+			slower = slower || (significant && change > 0);
+		}
+		std::cerr << '\n';
+	}
+	out << "  ]\n}\n";
+	return slower ? 3 : 0;
+}
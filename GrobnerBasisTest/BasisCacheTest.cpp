@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/BasisCache.h"
+#include <fstream>
+#include <thread>
+#include <vector>
+
+class BasisCacheTest : public testing::Test
+{
+protected:
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "GrobnerBasisTest-BasisCache";
+
+	void SetUp() override { std::filesystem::remove_all(directory); }
+	void TearDown() override { std::filesystem::remove_all(directory); }
+
+	//the number of entries in the directory
+	size_t entries() const
+	{
+		return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+	}
+};
+
+TEST_F(BasisCacheTest, StoreLoadTest)
+{
+	BasisCache cache{ directory };
+	EXPECT_FALSE(cache.load("ideal"));
+	cache.store("ideal", "basis");
+	EXPECT_EQ(cache.load("ideal"), std::optional<std::string>("basis"));
+	cache.store("ideal", "other basis"); //replaced
+	EXPECT_EQ(cache.load("ideal"), std::optional<std::string>("other basis"));
+	EXPECT_FALSE(cache.load("ideal\n")); //descriptions must match exactly
+	cache.store("", "");
+	EXPECT_EQ(cache.load(""), std::optional<std::string>(""));
+
+	BasisCache shared{ directory }; //another user of the same directory
+	EXPECT_EQ(shared.load("ideal"), std::optional<std::string>("other basis"));
+	EXPECT_EQ(entries(), 2);
+}
+
+TEST_F(BasisCacheTest, ConcurrentTest)
+{
+	BasisCache cache{ directory };
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t)
+		threads.emplace_back([&, t]()
+		{
+			for (int i = 0; i < 20; ++i)
+			{
+				std::string description = "ideal " + std::to_string(i % 4);
+				cache.store(description, description + std::string(100, 'x'));
+				auto loaded = cache.load(description);
+				if (loaded) //may have just been replaced, but never torn
+				{
+					EXPECT_EQ(*loaded, description + std::string(100, 'x'));
+				}
+			}
+		});
+	for (auto& thread : threads)
+		thread.join();
+	EXPECT_EQ(entries(), 4); //no temporaries left behind
+}
+
+TEST_F(BasisCacheTest, EvictTest)
+{
+	BasisCache small{ directory, 300 }; //room for two entries
+	small.store("first", std::string(100, 'x'));
+	small.store("second", std::string(100, 'x'));
+	auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+	for (auto& entry : std::filesystem::directory_iterator(directory))
+		std::filesystem::last_write_time(entry.path(), past);
+	EXPECT_TRUE(small.load("first")); //now more recently used than second
+	small.store("third", std::string(100, 'x')); //over the limit
+	EXPECT_TRUE(small.load("first"));
+	EXPECT_FALSE(small.load("second"));
+	EXPECT_TRUE(small.load("third"));
+
+	BasisCache young{ directory, BasisCache::defaultMaxBytes, std::chrono::minutes(1) };
+	std::ofstream(directory / "stray.tmp") << "left by a writer that died";
+	for (auto& entry : std::filesystem::directory_iterator(directory))
+		std::filesystem::last_write_time(entry.path(), past);
+	EXPECT_TRUE(young.load("third")); //used again
+	young.evict();
+	EXPECT_EQ(entries(), 1);
+	EXPECT_TRUE(young.load("third"));
+}
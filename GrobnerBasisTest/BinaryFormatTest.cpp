@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/BinaryReader.h"
+#include "../GrobnerBasisLib/BinaryWriter.h"
+#include "../GrobnerBasisLib/MappedFile.h"
+#include <fstream>
+#include <sstream>
+
+class BinaryFormatTest : public testing::Test
+{
+protected:
+	using Q = Rational<>;
+	using P = Polynomial<Q>;
+	P x{ PowerProduct(0) };
+	P y{ PowerProduct(1) };
+	P z{ PowerProduct(5) };
+	BinaryFormat::Header header{ { "x","y" }, { { 1,1 }, { 0,-1 } }, "" };
+
+	//write the polynomials and return the bytes
+	template <typename CoefT>
+	std::string write(const std::vector<Polynomial<CoefT>>& polys)
+	{
+		std::ostringstream out;
+		BinaryWriter<CoefT> writer(out, header);
+		for (const auto& p : polys)
+			writer.write(p);
+		writer.finish();
+		return out.str();
+	}
+
+	//read back all the polynomials in bytes
+	template <typename CoefT>
+	std::vector<Polynomial<CoefT>> read(const std::string& bytes)
+	{
+		BinaryReader<CoefT> reader(bytes.data(), bytes.size());
+		std::vector<Polynomial<CoefT>> polys;
+		for (Polynomial<CoefT> p; reader.read(p);)
+			polys.push_back(p);
+		return polys;
+	}
+};
+
+TEST_F(BinaryFormatTest, IntegerTest)
+{
+	std::ostringstream out;
+	BinaryFormat::Output output(out);
+	std::int64_t signedValues[] = { 0, -1, 1, 63, -64, 64, INT64_MAX, INT64_MIN };
+	std::uint64_t unsignedValues[] = { 0, 127, 128, 300, UINT64_MAX };
+	for (auto v : signedValues)
+		output.writeSigned(v);
+	for (auto v : unsignedValues)
+		output.writeUnsigned(v);
+	output.writeFixed(0x0123456789abcdef);
+
+	std::string bytes = out.str();
+	EXPECT_EQ(bytes.size(), 1 + 1 + 1 + 1 + 1 + 2 + 10 + 10 + 1 + 1 + 2 + 2 + 10 + 8); //small values stay short
+	BinaryFormat::Input input(bytes.data(), bytes.data() + bytes.size());
+	for (auto v : signedValues)
+		EXPECT_EQ(input.readSigned(), v);
+	for (auto v : unsignedValues)
+		EXPECT_EQ(input.readUnsigned(), v);
+	EXPECT_EQ(input.readFixed(), 0x0123456789abcdef);
+	EXPECT_THROW(input.readUnsigned(), BinaryFormat::FormatException); //past the end
+}
+
+TEST_F(BinaryFormatTest, PolynomialTest)
+{
+	std::vector<P> polys{ 0, 1, Q(-2, 3) * x.pow(3) * y + z.pow(100) - Q(7, 5), (x + y + 1).pow(6) };
+	std::string bytes = write(polys);
+	EXPECT_EQ(read<Q>(bytes), polys);
+
+	BinaryReader<Q> reader(bytes.data(), bytes.size());
+	EXPECT_EQ(reader.header().variables, header.variables);
+	EXPECT_EQ(reader.header().termOrder, header.termOrder);
+	EXPECT_EQ(reader.header().coefficients, "rational32");
+
+	std::vector<Polynomial<double>> doubles{ Polynomial<double>(0.1) * PowerProduct(2) - 1e300 };
+	EXPECT_EQ(read<double>(write(doubles)), doubles); //exact
+}
+
+TEST_F(BinaryFormatTest, DamagedTest)
+{
+	std::string bytes = write(std::vector<P>{ x * y - 1, x.pow(2) });
+	EXPECT_THROW(read<double>(bytes), BinaryFormat::FormatException); //wrong coefficients
+	EXPECT_THROW(read<Q>("GRBM" + bytes.substr(4)), BinaryFormat::FormatException); //not the format
+	for (size_t length = 0; length < bytes.size(); ++length) //every truncation is caught
+		EXPECT_THROW(read<Q>(bytes.substr(0, length)), BinaryFormat::FormatException);
+
+	std::string huge = bytes.substr(0, bytes.size() - 1); //a term count far larger than the file
+	huge += std::string(9, '\xff') + '\x01';
+	EXPECT_THROW(read<Q>(huge), BinaryFormat::FormatException);
+}
+
+TEST_F(BinaryFormatTest, MappedFileTest)
+{
+	auto path = std::filesystem::temp_directory_path() / "GrobnerBasisTest-MappedFile";
+	std::vector<P> polys{ x.pow(2) - y, z * x + Q(1, 2) };
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << write(polys);
+	}
+	{
+		MappedFile file(path);
+		std::string bytes(file.data(), file.size());
+		EXPECT_EQ(read<Q>(bytes), polys);
+		MappedFile moved(std::move(file));
+		EXPECT_EQ(moved.size(), bytes.size());
+	}
+	std::ofstream(path, std::ios::trunc).close();
+	EXPECT_EQ(MappedFile(path).size(), 0);
+	std::filesystem::remove(path);
+	EXPECT_THROW(MappedFile{ path }, std::system_error);
+}
@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/Budget.h"
+#include <thread>
+
+class BudgetTest : public testing::Test
+{
+protected:
+	Budget budget;
+};
+
+TEST_F(BudgetTest, LimitTest)
+{
+	budget.check(1000, 1000, 1000); //no limits by default
+	budget.setMaxPairs(10);
+	budget.setMaxBasisSize(5);
+	budget.setMaxMemory(100);
+	budget.check(10, 5, 100);
+	try
+	{
+		budget.check(11, 5, 100);
+		FAIL();
+	}
+	catch (Budget::ExceededException& e)
+	{
+		EXPECT_EQ(e.reason(), Budget::Pairs);
+		EXPECT_STREQ(e.what(), "budget of 10 critical pairs exceeded");
+	}
+	EXPECT_THROW(budget.check(10, 6, 100), Budget::ExceededException);
+	EXPECT_THROW(budget.check(10, 5, 101), std::runtime_error);
+}
+
+TEST_F(BudgetTest, CancelTest)
+{
+	budget.setTimeLimit(std::chrono::hours(1));
+	budget.check();
+	std::thread([&]() { budget.cancel(); }).join();
+	EXPECT_TRUE(budget.cancelled());
+	try
+	{
+		budget.check();
+		FAIL();
+	}
+	catch (Budget::ExceededException& e)
+	{
+		EXPECT_EQ(e.reason(), Budget::Cancelled);
+	}
+
+	Budget late;
+	late.setDeadline(Budget::Clock::now() - std::chrono::seconds(1));
+	EXPECT_THROW(late.check(), Budget::ExceededException);
+}
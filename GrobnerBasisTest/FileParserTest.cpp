@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/FileParser.h"
+#include "../GrobnerBasisLib/RationalParser.h"
+#include <fstream>
+#include <system_error>
+
+class FileParserTest : public testing::Test
+{
+protected:
+	std::filesystem::path file = std::filesystem::temp_directory_path() / "GrobnerBasisTest-FileParser.txt";
+	RationalParser parser{ "x","y" };
+	Polynomial<Rational<>> x{ PowerProduct(0) };
+	Polynomial<Rational<>> y{ PowerProduct(1) };
+
+	void TearDown() override { std::filesystem::remove(file); }
+
+	//replaces the file with contents
+	void write(const std::string& contents)
+	{
+		std::ofstream(file, std::ios::binary) << contents;
+	}
+};
+
+TEST_F(FileParserTest, ParseTest)
+{
+	write("x^2 - y, x*y\n\n  y + 1 ,\r\n-x\n,\n");
+	std::vector<Polynomial<Rational<>>> expected{ x.pow(2) - y, x * y, y + 1, -x };
+	EXPECT_EQ(FileParser<Polynomial<Rational<>>>(parser).parse(file), expected);
+	auto pool = std::make_shared<ThreadPool>(4);
+	EXPECT_EQ(FileParser<Polynomial<Rational<>>>(parser, pool).parse(file), expected);
+
+	//many more items than threads, still in order
+	std::string contents;
+	expected.clear();
+	for (int i = 1; i <= 200; ++i)
+	{
+		contents += "x^" + std::to_string(i) + " + " + std::to_string(i) + "*y\n";
+		expected.push_back(x.pow(i) + i * y);
+	}
+	write(contents);
+	EXPECT_EQ(FileParser<Polynomial<Rational<>>>(parser, pool).parse(file), expected);
+
+	write(" \n\n");
+	EXPECT_TRUE(FileParser<Polynomial<Rational<>>>(parser, pool).parse(file).empty());
+	write("");
+	EXPECT_TRUE(FileParser<Polynomial<Rational<>>>(parser, pool).parse(file).empty());
+}
+
+TEST_F(FileParserTest, ErrorTest)
+{
+	//the first error in the file is reported, with its line and column
+	write("x + y,\nx*y, x + w\ny + z\n");
+	auto pool = std::make_shared<ThreadPool>(4);
+	try
+	{
+		FileParser<Polynomial<Rational<>>>(parser, pool).parse(file);
+		FAIL();
+	}
+	catch (RationalParser::ParseException& ex)
+	{
+		EXPECT_EQ(ex.position(), 16);
+		EXPECT_EQ(std::string(ex.what()).rfind(file.string() + ":2:10: unknown variable name w", 0), 0);
+	}
+
+	std::filesystem::remove(file);
+	EXPECT_THROW(FileParser<Polynomial<Rational<>>>(parser).parse(file), std::system_error);
+}
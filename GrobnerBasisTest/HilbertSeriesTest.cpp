@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/HilbertSeries.h"
+#include <random>
+#include <vector>
+
+class HilbertSeriesTest : public testing::Test
+{
+protected:
+	PowerProduct x{ 0 };
+	PowerProduct y{ 1 };
+	PowerProduct z{ 2 };
+};
+
+TEST_F(HilbertSeriesTest, WholeRingTest)
+{
+	HilbertSeries ring(3);
+	EXPECT_EQ(ring.numerator(), std::vector<long long>{ 1 });
+	EXPECT_EQ(ring.expand(4), (std::vector<long long>{ 1, 3, 6, 10 }));
+	EXPECT_EQ(ring.function(-1), 0);
+	EXPECT_EQ(ring.dimension(), 3);
+	EXPECT_EQ(ring.degree(), 1);
+
+	//the quotient by the ideal of 1 is zero
+	std::vector<PowerProduct> one{ PowerProduct(), x };
+	HilbertSeries zero(one, 3);
+	EXPECT_TRUE(zero.numerator().empty());
+	EXPECT_EQ(zero.function(2), 0);
+	EXPECT_EQ(zero.dimension(), -1);
+	EXPECT_EQ(zero.degree(), 0);
+	EXPECT_EQ(zero.toString(), "(0)/(1-t)^3");
+}
+
+TEST_F(HilbertSeriesTest, NumeratorTest)
+{
+	std::vector<PowerProduct> powers{ x.pow(2), y.pow(3) }; //coprime
+	HilbertSeries complete(powers.begin(), powers.end());
+	EXPECT_EQ(complete.variables(), 2);
+	EXPECT_EQ(complete.numerator(), (std::vector<long long>{ 1, 0, -1, -1, 0, 1 }));
+	EXPECT_EQ(complete.expand(5), (std::vector<long long>{ 1, 2, 2, 1, 0 }));
+	EXPECT_EQ(complete.dimension(), 0);
+	EXPECT_EQ(complete.degree(), 6);
+	EXPECT_EQ(complete.toString(), "(1 - t^2 - t^3 + t^5)/(1-t)^2");
+
+	std::vector<PowerProduct> line{ x * y, y.pow(2), x * y.pow(2) }; //the last is redundant
+	HilbertSeries affineLine(line, 2);
+	EXPECT_EQ(affineLine.numerator(), (std::vector<long long>{ 1, 0, -2, 1 }));
+	EXPECT_EQ(affineLine.expand(5), (std::vector<long long>{ 1, 2, 1, 1, 1 }));
+	EXPECT_EQ(affineLine.dimension(), 1);
+	EXPECT_EQ(affineLine.degree(), 1);
+	EXPECT_EQ(affineLine, HilbertSeries(std::vector<long long>{ 1, 1, -1 }, 1)); //cancelled
+	EXPECT_NE(affineLine, complete);
+}
+
+TEST_F(HilbertSeriesTest, CountTest)
+{
+	//the Hilbert function counts the power products of each degree outside the ideal
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> degree(0, 4);
+	for (int trial = 0; trial < 20; ++trial)
+	{
+		std::vector<PowerProduct> generators;
+		for (int g = 0; g < 6; ++g)
+		{
+			PowerProduct p;
+			for (size_t n = 0; n < 4; ++n)
+				p *= PowerProduct(n).pow(degree(random));
+			if (p != PowerProduct())
+				generators.push_back(p);
+		}
+		HilbertSeries series(generators, 4);
+		std::vector<long long> counts(9);
+		for (int a = 0; a < 9; ++a)
+			for (int b = 0; a + b < 9; ++b)
+				for (int c = 0; a + b + c < 9; ++c)
+					for (int d = 0; a + b + c + d < 9; ++d)
+					{
+						PowerProduct p = x.pow(a) * y.pow(b) * z.pow(c) * PowerProduct(3).pow(d);
+						if (std::none_of(generators.begin(), generators.end(),
+							[&](const PowerProduct& g) { return p.isDivisibleBy(g); }))
+							++counts[a + b + c + d];
+					}
+		EXPECT_EQ(series.expand(9), counts);
+	}
+}
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/IdealRegistry.h"
+#include "../GrobnerBasisLib/Rational.h"
+
+class IdealRegistryTest : public testing::Test
+{
+protected:
+	using Q = Rational<>;
+	using P = Polynomial<Q>;
+	using I = Ideal<Q>;
+	P x{ PowerProduct(1) };
+	P y{ PowerProduct(0) };
+	I small{ { x - 1 } };
+	I large{ { x.pow(3) * y - 2 * x + 1, y.pow(3) * x - y + 5 } };
+};
+
+TEST_F(IdealRegistryTest, StoreTest)
+{
+	IdealRegistry<Q> registry;
+	EXPECT_EQ(registry.find("i"), nullptr);
+	EXPECT_TRUE(registry.store("i", small).empty());
+	auto i = registry.find("i");
+	ASSERT_NE(i, nullptr);
+	EXPECT_TRUE(i->isMember(x.pow(2) - 1));
+
+	//replacing leaves earlier users with the ideal they had
+	registry.store("i", large);
+	EXPECT_TRUE(i->isMember(x.pow(2) - 1));
+	EXPECT_FALSE(registry.find("i")->isMember(x.pow(2) - 1));
+	EXPECT_EQ(registry.size(), 1);
+	EXPECT_EQ(registry.bytes(), IdealRegistry<Q>::footprint(large));
+	EXPECT_GT(IdealRegistry<Q>::footprint(large), IdealRegistry<Q>::footprint(small));
+
+	EXPECT_TRUE(registry.erase("i"));
+	EXPECT_FALSE(registry.erase("i"));
+	EXPECT_EQ(registry.size(), 0);
+	EXPECT_EQ(registry.bytes(), 0);
+}
+
+TEST_F(IdealRegistryTest, EvictTest)
+{
+	IdealRegistry<Q> registry(2);
+	registry.store("a", small);
+	registry.store("b", small);
+	registry.find("a"); //now b is the least recently used
+	EXPECT_EQ(registry.store("c", small), std::vector<std::string>{ "b" });
+	auto entries = registry.entries();
+	ASSERT_EQ(entries.size(), 2);
+	EXPECT_EQ(entries[0].name, "c");
+	EXPECT_EQ(entries[1].name, "a");
+
+	//by size, keeping the newest even if it is too large on its own
+	IdealRegistry<Q> bounded(0, IdealRegistry<Q>::footprint(small) * 2);
+	bounded.store("a", small);
+	bounded.store("b", small);
+	EXPECT_EQ(bounded.store("c", large), (std::vector<std::string>{ "a", "b" }));
+	EXPECT_EQ(bounded.size(), 1);
+	EXPECT_NE(bounded.find("c"), nullptr);
+}
@@ -1,8 +1,11 @@
 #include "pch.h"
 #include "../GrobnerBasisLib/LexTermOrder.h"
 #include "../GrobnerBasisLib/DegLexTermOrder.h"
+#include "../GrobnerBasisLib/DegRevLexTermOrder.h"
+#include "../GrobnerBasisLib/MatrixTermOrder.h"
 #include "../GrobnerBasisLib/Rational.h"
 #include "../GrobnerBasisLib/Ideal.h"
+#include <fstream>
 
 
 class IdealTest : public testing::Test
@@ -31,6 +34,14 @@ TEST_F(IdealTest, MemberTest)
 	EXPECT_TRUE(j.isMember(3 * x.pow(5) - 2 * y * x));
 	EXPECT_FALSE(j.isMember(x.pow(2) + 3));
 	EXPECT_TRUE(i.isMember((x * y - x) * y * x - (-y + x.pow(2)) * x.pow(2)));
+
+	EXPECT_TRUE(I().isMember(0)); //zero ideal
+	EXPECT_FALSE(I().isMember(1));
+	EXPECT_TRUE(I({ x + 1, x }).isMember(y.pow(3) + 2)); //whole ring
+	EXPECT_FALSE(I({ x.pow(2) * y }).isMember(x * y)); //degree too low
+	EXPECT_FALSE(I({ x * y - 1 }).isMember(x.pow(5) + 1)); //every leading power needs y
+	EXPECT_TRUE(I({ x * y - 1 }).isMember(x.pow(3) * y.pow(2) - x.pow(2) * y));
+	EXPECT_FALSE(i.isMember(x.pow(4) + y.pow(7))); //irreducible term below the leading term
 }
 
 TEST_F(IdealTest, ReduceTest)
@@ -55,4 +66,373 @@ TEST_F(IdealTest, SetTermOrderTest)
 	EXPECT_EQ(k.reduce(y), y);
 
 	EXPECT_THROW(k.setTermOrder(nullptr), std::exception);
-}
\ No newline at end of file
+}
+
+TEST_F(IdealTest, ZeroDimensionalTest)
+{
+	EXPECT_TRUE(j.isZeroDimensional());
+	EXPECT_FALSE(I({ x.pow(2) - y }).isZeroDimensional());
+	EXPECT_TRUE(I({ 1 }).isZeroDimensional());
+	EXPECT_FALSE(I().isZeroDimensional());
+}
+
+TEST_F(IdealTest, FGLMTest)
+{
+	//a zero-dimensional ideal: converting must give the basis computed from scratch
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y * z, y.pow(2) - z + 1, z.pow(2) - x * y - 1 };
+	I converted{ gens, gens + 3, std::make_unique<DegRevLexTermOrder>() };
+	ASSERT_TRUE(converted.isZeroDimensional());
+	converted.setTermOrder(std::make_unique<LexTermOrder>());
+	I direct{ gens, gens + 3, std::make_unique<LexTermOrder>() };
+
+	EXPECT_EQ(std::vector<P>(converted.begin(), converted.end()), std::vector<P>(direct.begin(), direct.end()));
+
+	converted.setTermOrder(std::make_unique<DegLexTermOrder>()); //and back again
+	I directDeglex{ gens, gens + 3, std::make_unique<DegLexTermOrder>() };
+	EXPECT_EQ(std::vector<P>(converted.begin(), converted.end()), std::vector<P>(directDeglex.begin(), directDeglex.end()));
+}
+
+TEST_F(IdealTest, ThreadCountTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x + y + z, x * y + y * z + z * x, x * y * z - 1, x.pow(2) * y - z.pow(3) + 2 };
+	I serial{ gens, gens + 4 };
+	I parallel;
+	parallel.setThreadCount(4);
+	parallel.setGenerators(gens, gens + 4);
+
+	EXPECT_EQ(parallel.threadCount(), 4u);
+	EXPECT_TRUE(parallel.equals(serial));
+	for (const P& p : { x.pow(5), x * y.pow(3) - z, z.pow(4) * y })
+		EXPECT_EQ(parallel.reduce(p), serial.reduce(p));
+}
+
+TEST_F(IdealTest, BatchTest)
+{
+	P polys[] = { x.pow(2) + y - 3, 3 * x.pow(5) - 2 * y * x, x.pow(2) + 3, 0 };
+	std::vector<P> remainders;
+	j.reduceAll(polys, polys + 4, std::back_inserter(remainders));
+	std::vector<bool> members;
+	j.isMemberAll(polys, polys + 4, std::back_inserter(members));
+
+	ASSERT_EQ(remainders.size(), 4u);
+	ASSERT_EQ(members.size(), 4u);
+	for (size_t n = 0; n < 4; ++n)
+	{
+		EXPECT_EQ(remainders[n], j.reduce(polys[n]));
+		EXPECT_EQ(members[n], j.isMember(polys[n]));
+	}
+
+	//the same answers from a thread pool, with concurrent callers
+	I k{ basis,basis + 3 };
+	k.setThreadCount(4);
+	std::vector<std::thread> callers;
+	std::vector<P> results[4];
+	for (auto& result : results)
+		callers.emplace_back([&]() { k.reduceAll(polys, polys + 4, std::back_inserter(result)); });
+	for (auto& caller : callers)
+		caller.join();
+	for (auto& result : results)
+		EXPECT_EQ(result, remainders);
+}
+
+TEST_F(IdealTest, MemberOfTest)
+{
+	P gens[] = { x * y - x, -y + x.pow(2) };
+	EXPECT_TRUE(I::isMemberOf(gens, gens + 2, (x * y - x) * y * x - (-y + x.pow(2)) * x.pow(2)));
+	EXPECT_TRUE(I::isMemberOf(gens, gens + 2, x.pow(3) - x)); //needs a new basis element
+	EXPECT_FALSE(I::isMemberOf(gens, gens + 2, x.pow(2) + 3, std::make_unique<DegLexTermOrder>()));
+	EXPECT_TRUE(I::isMemberOf(gens, gens + 2, 0));
+	EXPECT_FALSE(I::isMemberOf(gens, gens, 1)); //zero ideal
+}
+
+TEST_F(IdealTest, WalkTest)
+{
+	//positive-dimensional: converting must give the basis computed from scratch
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x }; //a space curve
+	I converted{ gens, gens + 3, std::make_unique<DegRevLexTermOrder>() };
+	ASSERT_FALSE(converted.isZeroDimensional());
+	auto walkTo = [&](std::unique_ptr<PowerProduct::TermOrder> order)
+	{
+		I direct{ gens, gens + 3, std::make_unique<MatrixTermOrder>(order->matrix(3)) };
+		converted.setTermOrder(std::move(order));
+		EXPECT_EQ(std::vector<P>(converted.begin(), converted.end()), std::vector<P>(direct.begin(), direct.end()));
+	};
+	walkTo(std::make_unique<LexTermOrder>());
+	walkTo(std::make_unique<MatrixTermOrder>(PowerProduct::TermOrder::Matrix{ { 1,2,3 } }));
+	walkTo(std::make_unique<DegLexTermOrder>());
+}
+
+TEST_F(IdealTest, AddGeneratorsTest)
+{
+	//one generator at a time must give the basis computed all at once
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x, x * y * z - 3 };
+	for (int threads : { 1, 4 })
+	{
+		I grown;
+		grown.setThreadCount(threads);
+		for (int n = 1; n <= 4; ++n)
+		{
+			grown.addGenerators(gens + n - 1, gens + n);
+			I direct{ gens, gens + n };
+			EXPECT_EQ(std::vector<P>(grown.begin(), grown.end()), std::vector<P>(direct.begin(), direct.end()));
+		}
+		std::vector<P> before(grown.begin(), grown.end());
+		grown.addGenerators(gens, gens + 2); //already members
+		EXPECT_EQ(std::vector<P>(grown.begin(), grown.end()), before);
+	}
+
+	I k{ { x.pow(2) * y } };
+	P more[] = { x.pow(2) - 1 };
+	k.addGenerators(more, more + 1);
+	EXPECT_TRUE(k.equals(I({ x.pow(2) - 1, y })));
+}
+
+TEST_F(IdealTest, CacheTest)
+{
+	auto directory = std::filesystem::temp_directory_path() / "GrobnerBasisTest-IdealCache";
+	std::filesystem::remove_all(directory);
+	auto cache = std::make_shared<BasisCache>(directory);
+	P gens[] = { x * y - x, -y + x.pow(2) };
+	P same[] = { x.pow(2) - y, 3 * x * y - 3 * x, x.pow(2) - y }; //reordered, scaled, and repeated
+
+	I computed{ gens, gens + 2, std::make_unique<DegLexTermOrder>(), cache };
+	I loaded{ same, same + 3, std::make_unique<DegLexTermOrder>(), cache };
+	auto entries = [&]() { return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()); };
+	EXPECT_EQ(entries(), 1);
+	EXPECT_EQ(std::vector<P>(loaded.begin(), loaded.end()), std::vector<P>(computed.begin(), computed.end()));
+	EXPECT_TRUE(loaded.isMember(x.pow(3) - x));
+
+	loaded.setGenerators(gens, gens + 1); //a different ideal
+	EXPECT_EQ(entries(), 2);
+	I lex{ gens, gens + 2, std::make_unique<LexTermOrder>(), cache }; //a different order
+	EXPECT_EQ(entries(), 3);
+
+	for (auto& entry : std::filesystem::directory_iterator(directory)) //damage the entries
+		std::ofstream(entry.path(), std::ios::app) << "garbage";
+	I recomputed{ same, same + 3, std::make_unique<DegLexTermOrder>(), cache };
+	EXPECT_EQ(std::vector<P>(recomputed.begin(), recomputed.end()), std::vector<P>(computed.begin(), computed.end()));
+	std::filesystem::remove_all(directory);
+}
+
+TEST_F(IdealTest, WriteReadTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1 };
+	I computed{ gens, gens + 2, std::make_unique<DegRevLexTermOrder>() };
+	std::ostringstream out;
+	computed.write(out, { "y","x","z" });
+	std::string bytes = out.str();
+
+	BinaryReader<Q> reader(bytes.data(), bytes.size());
+	EXPECT_EQ(reader.header().variables, std::vector<std::string>({ "y","x","z" }));
+	I loaded;
+	loaded.read(reader);
+	EXPECT_EQ(std::vector<P>(loaded.begin(), loaded.end()), std::vector<P>(computed.begin(), computed.end()));
+	EXPECT_EQ(loaded.reduce(x.pow(3)), computed.reduce(x.pow(3)));
+	EXPECT_TRUE(loaded.isMember(x.pow(3) - z + 1));
+	loaded.setTermOrder(std::make_unique<LexTermOrder>()); //usable like any other basis
+	EXPECT_TRUE(loaded.equals(computed));
+
+	BinaryReader<Q> truncated(bytes.data(), bytes.size() - 1);
+	EXPECT_THROW(loaded.read(truncated), BinaryFormat::FormatException);
+	EXPECT_TRUE(loaded.equals(computed)); //unchanged
+}
+
+TEST_F(IdealTest, StatisticsTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x };
+	I k;
+	k.setGenerators(gens, gens + 3);
+	EXPECT_EQ(k.statistics().pairsCreated, 0); //not collected by default
+	EXPECT_EQ(k.statistics().maxBasisSize, 0);
+
+	k.setStatisticsEnabled(true);
+	k.setGenerators(gens, gens + 3);
+	const auto& stats = k.statistics();
+	EXPECT_GT(stats.pairsReduced, 0);
+	EXPECT_EQ(stats.pairsCreated, stats.pairsPruned + stats.pairsReduced);
+	EXPECT_LE(stats.zeroReductions, stats.pairsReduced);
+	EXPECT_GT(stats.reductionSteps, 0);
+	EXPECT_GE(stats.maxBasisSize, static_cast<size_t>(std::distance(k.begin(), k.end())));
+	EXPECT_GE(stats.maxTerms, 3);
+	EXPECT_GE(stats.computeSeconds, 0);
+
+	//coprime leading powers: the only pair is pruned
+	k.resetStatistics();
+	P coprime[] = { x.pow(2) + 1, y.pow(3) + 1 };
+	k.setGenerators(coprime, coprime + 2);
+	EXPECT_EQ(stats.pairsCreated, 1);
+	EXPECT_EQ(stats.pairsPruned, 1);
+	EXPECT_EQ(stats.pairsReduced, 0);
+
+	//1/8*x + 3 is made monic as x + 24, of 5 bits
+	k.resetStatistics();
+	P scaled[] = { Q(1, 8) * x + 3 };
+	k.setGenerators(scaled, scaled + 1);
+	EXPECT_EQ(stats.maxCoefficientBits, 5);
+	EXPECT_EQ(stats.maxBasisSize, 1);
+
+	k.setStatisticsEnabled(false);
+	k.setGenerators(gens, gens + 3);
+	EXPECT_EQ(stats.maxBasisSize, 1); //unchanged
+}
+
+TEST_F(IdealTest, MemoryTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x };
+	I k;
+	k.setGenerators(gens, gens + 3);
+	EXPECT_EQ(k.memory().peak(), 0); //not counted by default
+	k.setStatisticsEnabled(true);
+	k.setGenerators(gens, gens + 3);
+	EXPECT_EQ(k.memory().peak(), 0); //nor with statistics
+
+	k.setMemoryCountingEnabled(true);
+	k.setGenerators(gens, gens + 3);
+	EXPECT_GT(k.memory().current(MemoryAccount::Basis), 0);
+	EXPECT_GT(k.memory().peak(MemoryAccount::Pairs), 0);
+	EXPECT_GT(k.memory().peak(MemoryAccount::Temporaries), 0);
+	EXPECT_EQ(k.memory().current(MemoryAccount::Pairs), 0);
+	EXPECT_EQ(k.memory().current(MemoryAccount::Temporaries), 0);
+	std::vector<P> expected(k.begin(), k.end());
+
+	//over the limit, the ideal is left as it was
+	P more[] = { x * y * z - 3 };
+	k.setMemoryLimit(k.memory().current() + 1);
+	EXPECT_THROW(k.addGenerators(more, more + 1), MemoryAccount::LimitException);
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), expected);
+	EXPECT_THROW(k.setGenerators(more, more + 1), std::bad_alloc);
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), expected);
+	EXPECT_TRUE(k.isMember(x.pow(2) - y));
+
+	k.setMemoryLimit(0);
+	k.addGenerators(more, more + 1);
+	I direct{ { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x, x * y * z - 3 } };
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), std::vector<P>(direct.begin(), direct.end()));
+}
+
+TEST_F(IdealTest, BudgetTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x };
+	I k;
+	k.setGenerators(gens, gens + 3);
+	std::vector<P> expected(k.begin(), k.end());
+
+	//each limit stops the computation, leaving the ideal as it was
+	P more[] = { x * y * z - 3, z.pow(3) - x };
+	P all[] = { gens[0], gens[1], gens[2], more[0], more[1] };
+	auto budget = std::make_shared<Budget>();
+	k.setBudget(budget);
+	budget->setMaxPairs(2);
+	EXPECT_THROW(k.setGenerators(all, all + 5), Budget::ExceededException);
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), expected);
+	budget->setMaxPairs(0);
+	budget->setMaxBasisSize(expected.size());
+	try
+	{
+		k.addGenerators(more, more + 2);
+		FAIL();
+	}
+	catch (Budget::ExceededException& e)
+	{
+		EXPECT_EQ(e.reason(), Budget::BasisSize);
+	}
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), expected);
+	budget->setMaxBasisSize(0);
+	budget->setMaxMemory(1);
+	EXPECT_THROW(k.setGenerators(all, all + 5), Budget::ExceededException);
+	budget->setMaxMemory(0);
+	budget->setDeadline(Budget::Clock::now());
+	EXPECT_THROW(k.setTermOrder(std::make_unique<DegRevLexTermOrder>()), Budget::ExceededException);
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), expected);
+	EXPECT_THROW(k.reduce(x.pow(3)), Budget::ExceededException);
+
+	//cancelling stops everything checking the budget, until it is replaced
+	auto cancelled = std::make_shared<Budget>();
+	cancelled->cancel();
+	k.setBudget(cancelled);
+	EXPECT_THROW(k.isMember(x.pow(2) - y), Budget::ExceededException);
+	k.setBudget(nullptr);
+	EXPECT_TRUE(k.isMember(x.pow(2) - y));
+	k.addGenerators(more, more + 2);
+	I direct{ { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x, x * y * z - 3, z.pow(3) - x } };
+	EXPECT_EQ(std::vector<P>(k.begin(), k.end()), std::vector<P>(direct.begin(), direct.end()));
+}
+
+TEST_F(IdealTest, ProgressTest)
+{
+	P z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x };
+
+	//a copy computes on its own basis, and reports to the progress they share
+	I k = i;
+	auto progress = std::make_shared<Progress>();
+	k.setProgress(progress);
+	EXPECT_EQ(progress->phase(), Progress::Idle);
+	k.setGenerators(gens, gens + 3);
+	EXPECT_EQ(progress->phase(), Progress::Reducing);
+	EXPECT_GT(progress->pairsReduced(), 0);
+	EXPECT_EQ(progress->pairsLeft(), 0);
+	EXPECT_GT(progress->basisSize(), 0);
+	EXPECT_TRUE(k.isMember(y.pow(2) - x * z + x));
+	EXPECT_FALSE(i.isMember(y.pow(2) - x * z + x));
+	EXPECT_TRUE(i.isMember(x * y - x));
+	k.setTermOrder(std::make_unique<DegRevLexTermOrder>());
+	EXPECT_EQ(progress->phase(), Progress::Converting);
+	EXPECT_EQ(i.termOrder().matrix(2), LexTermOrder().matrix(2));
+	EXPECT_STREQ(Progress::name(Progress::Converting), "converting");
+}
+
+TEST_F(IdealTest, HilbertSeriesTest)
+{
+	//the twisted cubic, whose Hilbert function is 3d + 1 in every term order
+	P z{ PowerProduct(2) }, w{ PowerProduct(3) };
+	P gens[] = { x * z - y.pow(2), y * w - z.pow(2), x * w - y * z };
+	I lex{ gens, gens + 3, std::make_unique<LexTermOrder>() };
+	I degRevLex{ gens, gens + 3, std::make_unique<DegRevLexTermOrder>() };
+	EXPECT_TRUE(lex.isHomogeneous());
+	EXPECT_EQ(lex.hilbertSeries().expand(5), (std::vector<long long>{ 1, 4, 7, 10, 13 }));
+	EXPECT_EQ(lex.hilbertSeries(4), degRevLex.hilbertSeries(4));
+	EXPECT_EQ(lex.hilbertSeries().dimension(), 2);
+	EXPECT_EQ(lex.hilbertSeries().degree(), 3);
+	EXPECT_EQ(I().hilbertSeries(2), HilbertSeries(2));
+	EXPECT_FALSE(i.isHomogeneous());
+}
+
+TEST_F(IdealTest, HilbertDrivenTest)
+{
+	P z{ PowerProduct(2) }, w{ PowerProduct(3) };
+	P gens[] = { x * z - y.pow(2), y * w - z.pow(2), x * w - y * z, x.pow(3) + w.pow(3) - y * z * w };
+	I expected{ gens, gens + 4, std::make_unique<DegRevLexTermOrder>() };
+	I direct{ gens, gens + 4, std::make_unique<LexTermOrder>() };
+
+	//knowing the series, pairs whose degree is complete are skipped, with the same basis
+	I driven;
+	driven.setStatisticsEnabled(true);
+	driven.setHilbertSeries(std::make_shared<HilbertSeries>(expected.hilbertSeries(4)));
+	driven.setGenerators(gens, gens + 4);
+	EXPECT_EQ(std::vector<P>(driven.begin(), driven.end()), std::vector<P>(direct.begin(), direct.end()));
+	const auto& stats = driven.statistics();
+	EXPECT_GT(stats.pairsSkipped, 0);
+	EXPECT_EQ(stats.pairsCreated, stats.pairsPruned + stats.pairsSkipped + stats.pairsReduced);
+
+	//converting a homogeneous ideal uses the series of its basis
+	expected.setStatisticsEnabled(true);
+	expected.resetStatistics();
+	expected.setTermOrder(std::make_unique<LexTermOrder>());
+	EXPECT_EQ(std::vector<P>(expected.begin(), expected.end()), std::vector<P>(direct.begin(), direct.end()));
+	EXPECT_GT(expected.statistics().pairsSkipped, 0);
+
+	//a series with fewer leading powers than the ideal has is noticed, leaving the basis as it was
+	I cone{ gens, gens + 1 };
+	driven.setHilbertSeries(std::make_shared<HilbertSeries>(cone.hilbertSeries(4)));
+	EXPECT_THROW(driven.setGenerators(gens, gens + 3), std::logic_error);
+	EXPECT_EQ(std::vector<P>(driven.begin(), driven.end()), std::vector<P>(direct.begin(), direct.end()));
+}
@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "../GrobnerBasisApp/Json.h"
+#include <string>
+
+class JsonTest : public testing::Test
+{
+protected:
+	Json request = Json::parse(R"( {"op": "member", "id": 3, "polynomials": ["x^2", "y"], "flag": true, "none": null} )");
+};
+
+TEST_F(JsonTest, ParseTest)
+{
+	EXPECT_EQ(request["op"].string(), "member");
+	EXPECT_EQ(request["id"].number(), 3);
+	ASSERT_EQ(request["polynomials"].array().size(), 2);
+	EXPECT_EQ(request["polynomials"].array()[1].string(), "y");
+	EXPECT_TRUE(request["flag"].boolean());
+	EXPECT_TRUE(request["none"].isNull());
+	EXPECT_TRUE(request["missing"].isNull());
+	EXPECT_EQ(Json::parse(R"(["a\"b",[],{}])").write(), R"(["a\"b",[],{}])");
+
+	EXPECT_THROW(Json::parse("{\"op\":}"), Json::ParseException);
+	EXPECT_THROW(Json::parse("[1,2"), Json::ParseException);
+	EXPECT_THROW(Json::parse("1 2"), Json::ParseException);
+	EXPECT_THROW(request["op"].number(), Json::ParseException);
+}
+
+TEST_F(JsonTest, DepthTest)
+{
+	//nesting is limited, so a hostile request fails to parse instead of overflowing the stack
+	std::string nested = std::string(1000, '[') + std::string(1000, ']');
+	EXPECT_EQ(Json::parse(nested).type(), Json::Array);
+	EXPECT_THROW(Json::parse(std::string(1001, '[') + std::string(1001, ']')), Json::ParseException);
+	EXPECT_THROW(Json::parse(std::string(200000, '[')), Json::ParseException);
+	EXPECT_THROW(Json::parse("{\"id\":" + std::string(200000, '{')), Json::ParseException);
+
+	//the depth is that of the brackets open at once, not their number
+	std::string wide = "[";
+	for (int i = 0; i < 2000; ++i)
+		wide += "[[]],";
+	wide += "[]]";
+	EXPECT_EQ(Json::parse(wide).array().size(), 2001);
+}
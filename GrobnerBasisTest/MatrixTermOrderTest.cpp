@@ -0,0 +1,44 @@
+#include "pch.h"
+#include "TermOrderTest.h"
+#include "../GrobnerBasisLib/MatrixTermOrder.h"
+#include "../GrobnerBasisLib/LexTermOrder.h"
+#include "../GrobnerBasisLib/DegLexTermOrder.h"
+#include "../GrobnerBasisLib/DegRevLexTermOrder.h"
+
+class MatrixTermOrderTest : public testing::Test, public TermOrderTest
+{
+protected:
+	MatrixTermOrder weighted{ {{ 1,2,3 }} };
+	MatrixTermOrder zeroWeights{ {{ 0,1 }} }; //only the second variable weighs anything
+};
+
+TEST_F(MatrixTermOrderTest, CompareTest)
+{
+	EXPECT_TRUE(weighted(powerProduct({ 2 }), powerProduct({ 0,0,1 }))); //weight 2 < 3
+	EXPECT_TRUE(weighted(powerProduct({ 0,0,1 }), powerProduct({ 3 }))); //tie broken by lex
+	EXPECT_FALSE(weighted(powerProduct({ 1,1 }), powerProduct({ 1,1 })));
+	EXPECT_TRUE(zeroWeights(powerProduct({ 5 }), powerProduct({ 0,1 })));
+	EXPECT_THROW(MatrixTermOrder({ { 1,-1 } }), std::logic_error);
+	EXPECT_NO_THROW(MatrixTermOrder({ { 1,0 }, { -1,1 } })); //second variable decided by the second row
+}
+
+TEST_F(MatrixTermOrderTest, MatrixTest)
+{
+	//each order must agree with its own matrix
+	LexTermOrder lex;
+	DegLexTermOrder deglex;
+	DegRevLexTermOrder degrevlex;
+	const PowerProduct::TermOrder* orders[] = { &lex, &deglex, &degrevlex, &weighted };
+	std::vector<PowerProduct> powers;
+	for (int a = 0; a < 3; ++a)
+		for (int b = 0; b < 3; ++b)
+			for (int c = 0; c < 3; ++c)
+				powers.push_back(powerProduct({ a,b,c }));
+	for (const auto* order : orders)
+	{
+		MatrixTermOrder asMatrix{ order->matrix(3) };
+		for (const auto& l : powers)
+			for (const auto& r : powers)
+				EXPECT_EQ((*order)(l, r), asMatrix(l, r));
+	}
+}
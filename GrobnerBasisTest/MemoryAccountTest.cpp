@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/MemoryAccount.h"
+#include "../GrobnerBasisLib/PowerProduct.h"
+#include <thread>
+#include <vector>
+
+class MemoryAccountTest : public testing::Test
+{
+protected:
+	std::shared_ptr<MemoryAccount> account = std::make_shared<MemoryAccount>();
+};
+
+TEST_F(MemoryAccountTest, CountTest)
+{
+	account->allocate(MemoryAccount::Basis, 100);
+	account->allocate(MemoryAccount::Pairs, 50);
+	account->flush(); //the peaks are taken as the changes are flushed
+	account->deallocate(MemoryAccount::Basis, 100);
+	EXPECT_EQ(account->current(MemoryAccount::Basis), 0);
+	EXPECT_EQ(account->peak(MemoryAccount::Basis), 100);
+	EXPECT_EQ(account->current(), 50);
+	EXPECT_EQ(account->peak(), 150);
+	account->resetPeaks();
+	EXPECT_EQ(account->peak(MemoryAccount::Basis), 0);
+	EXPECT_EQ(account->peak(), 50);
+	EXPECT_STREQ(MemoryAccount::name(MemoryAccount::Temporaries), "temporaries");
+}
+
+TEST_F(MemoryAccountTest, LimitTest)
+{
+	account->setLimit(100);
+	account->allocate(MemoryAccount::Basis, 60);
+	EXPECT_THROW(account->allocate(MemoryAccount::Temporaries, 60), MemoryAccount::LimitException);
+	EXPECT_THROW(account->allocate(MemoryAccount::Temporaries, 60), std::bad_alloc);
+	EXPECT_EQ(account->current(), 60); //nothing charged for the failures
+	EXPECT_EQ(account->current(MemoryAccount::Temporaries), 0);
+	account->allocate(MemoryAccount::Temporaries, 40);
+	account->setLimit(0);
+	account->allocate(MemoryAccount::Temporaries, 1000);
+	EXPECT_EQ(account->current(), 1100);
+}
+
+TEST_F(MemoryAccountTest, AllocatorTest)
+{
+	std::vector<int, CountingAllocator<int>> untracked;
+	untracked.resize(100);
+	{
+		MemoryAccount::Scope scope(account.get(), MemoryAccount::Temporaries);
+		std::vector<int, CountingAllocator<int>> v(100);
+		EXPECT_EQ(account->current(MemoryAccount::Temporaries), 100 * sizeof(int));
+
+		//copies are charged to the current scope; moves keep their charge
+		MemoryAccount::Scope inner(account.get(), MemoryAccount::Basis);
+		auto copy = v;
+		EXPECT_EQ(account->current(MemoryAccount::Basis), 100 * sizeof(int));
+		untracked = std::move(v);
+		EXPECT_EQ(account->current(MemoryAccount::Temporaries), 100 * sizeof(int));
+
+		//another thread has no scope
+		std::thread([&]() { std::vector<int, CountingAllocator<int>>(1000); }).join();
+		EXPECT_EQ(account->peak(), 200 * sizeof(int));
+
+		//what another thread counts is summed without being flushed
+		std::vector<int, CountingAllocator<int>> other;
+		std::thread([&]()
+		{
+			other = std::vector<int, CountingAllocator<int>>(CountingAllocator<int>(account.get(), MemoryAccount::Pairs));
+			other.resize(10);
+		}).join();
+		EXPECT_EQ(account->current(MemoryAccount::Pairs), 10 * sizeof(int));
+		other.clear();
+		other.shrink_to_fit();
+		EXPECT_EQ(account->current(MemoryAccount::Pairs), 0);
+	}
+	EXPECT_EQ(account->current(MemoryAccount::Basis), 0);
+	untracked.clear();
+	untracked.shrink_to_fit();
+	EXPECT_EQ(account->current(), 0);
+
+	std::vector<int, CountingAllocator<int>> pairs(CountingAllocator<int>(account.get(), MemoryAccount::Pairs));
+	pairs.push_back(1);
+	EXPECT_EQ(account->current(MemoryAccount::Pairs), sizeof(int));
+}
+
+TEST_F(MemoryAccountTest, HeapBytesTest)
+{
+	MemoryAccount::Scope scope(account.get(), MemoryAccount::Basis);
+	{
+		std::vector<std::pair<const PowerProduct, int>, CountingAllocator<std::pair<const PowerProduct, int>>> terms;
+		terms.reserve(2);
+		terms.emplace_back(PowerProduct(std::vector<int>{ 1, 2, 3 }), 1);
+		EXPECT_EQ(account->current(), 2 * sizeof(terms[0]) + heapBytes(terms[0].first));
+		EXPECT_GE(heapBytes(terms[0].first), 3 * sizeof(int));
+		terms.emplace_back(PowerProduct(), 2);
+		EXPECT_EQ(account->current(), 2 * sizeof(terms[0]) + heapBytes(terms[0].first));
+	}
+	EXPECT_EQ(account->current(), 0);
+}
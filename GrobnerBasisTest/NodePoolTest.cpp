@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/NodePool.h"
+#include "../GrobnerBasisLib/Polynomial.h"
+#include "../GrobnerBasisLib/LexTermOrder.h"
+#include <vector>
+
+class NodePoolTest : public testing::Test
+{
+};
+
+TEST_F(NodePoolTest, ReuseTest)
+{
+	void* first = nullptr;
+	{
+		NodePool::Scope scope;
+		first = NodePool::allocate(24);
+		NodePool::deallocate(first, 24);
+		EXPECT_EQ(NodePool::keptBytes(), 32); //rounded up to its size
+		EXPECT_EQ(NodePool::allocate(20), first); //same size, so the block is reused
+		EXPECT_EQ(NodePool::keptBytes(), 0);
+		{
+			NodePool::Scope inner;
+			NodePool::deallocate(first, 20);
+		}
+		EXPECT_EQ(NodePool::keptBytes(), 32); //only the outermost scope releases
+	}
+	EXPECT_EQ(NodePool::keptBytes(), 0);
+
+	//outside a scope, and for large blocks, nothing is kept
+	void* block = NodePool::allocate(24);
+	NodePool::deallocate(block, 24);
+	NodePool::Scope scope;
+	block = NodePool::allocate(NodePool::maxBlockBytes + 1);
+	NodePool::deallocate(block, NodePool::maxBlockBytes + 1);
+	EXPECT_EQ(NodePool::keptBytes(), 0);
+}
+
+TEST_F(NodePoolTest, PolynomialTest)
+{
+	//polynomials made in a scope survive it
+	Polynomial<double> p;
+	{
+		NodePool::Scope scope;
+		for (int i = 1; i <= 100; ++i)
+		{
+			Polynomial<double> temporary = i * Polynomial<double>(PowerProduct(std::vector<int>{ i, 1 }));
+			p += temporary * Polynomial<double>(PowerProduct(2));
+		}
+		EXPECT_GT(NodePool::keptBytes(), 0);
+	}
+	EXPECT_EQ(p.size(), 100);
+	EXPECT_EQ(p.leadingCoef(LexTermOrder()), 100);
+}
@@ -21,85 +21,97 @@ TYPED_TEST_CASE(PolynomialTest, CoefficientTypes);
 
 TYPED_TEST(PolynomialTest, AdditionTest)
 {
-	EXPECT_EQ(x + x, 2 * x);
-	EXPECT_EQ(x + x + y + y + y, 2 * x + 3 * y);
+	EXPECT_EQ(this->x + this->x, 2 * this->x);
+	EXPECT_EQ(this->x + this->x + this->y + this->y + this->y, 2 * this->x + 3 * this->y);
 }
 
 TYPED_TEST(PolynomialTest, NegationTest)
 {
-	EXPECT_EQ(-x, -1 * x);
-	EXPECT_EQ(-(x+y), -x+(-y));
+	EXPECT_EQ(-this->x, -1 * this->x);
+	EXPECT_EQ(-(this->x+this->y), -this->x+(-this->y));
 }
 
 TYPED_TEST(PolynomialTest, SubtractionTest)
 {
-	EXPECT_EQ(3 * x - 2 * x, x);
-	EXPECT_EQ(x - x, 0);
+	EXPECT_EQ(3 * this->x - 2 * this->x, this->x);
+	EXPECT_EQ(this->x - this->x, 0);
 }
 
 TYPED_TEST(PolynomialTest, MultiplicationTest)
 {
-	EXPECT_EQ(x * x, P(PowerProduct(0).pow(2)));
-	EXPECT_EQ((2 * x) * (3 * y), 6 * P(PowerProduct(0)*PowerProduct(1)));
-	EXPECT_EQ((x + y) * (x - y), x * x - y * y);
+	EXPECT_EQ(this->x * this->x, typename TestFixture::P(PowerProduct(0).pow(2)));
+	EXPECT_EQ((2 * this->x) * (3 * this->y), 6 * typename TestFixture::P(PowerProduct(0)*PowerProduct(1)));
+	EXPECT_EQ((this->x + this->y) * (this->x - this->y), this->x * this->x - this->y * this->y);
 }
 
 TYPED_TEST(PolynomialTest, PowerTest)
 {
-	EXPECT_EQ(x.pow(5), P(PowerProduct(0).pow(5)));
-	EXPECT_EQ((x + y).pow(2), x.pow(2) + 2 * x * y + y.pow(2));
-	EXPECT_EQ((x * y).pow(7), x.pow(7) * y.pow(7));
+	EXPECT_EQ(this->x.pow(5), typename TestFixture::P(PowerProduct(0).pow(5)));
+	EXPECT_EQ((this->x + this->y).pow(2), this->x.pow(2) + 2 * this->x * this->y + this->y.pow(2));
+	EXPECT_EQ((this->x * this->y).pow(7), this->x.pow(7) * this->y.pow(7));
 }
 
 TYPED_TEST(PolynomialTest, DivisibleByTest)
 {
-	EXPECT_TRUE((x.pow(2) * y.pow(3)).isDivisibleBy(x));
-	EXPECT_FALSE((x.pow(2) * y.pow(3)).isDivisibleBy(x.pow(3)));
-	EXPECT_TRUE((2 * x.pow(2) * y - 3 * x * y.pow(2)).isDivisibleBy(y));
-	EXPECT_FALSE((2 * x.pow(2) * y - 3 * x * y.pow(2) + x).isDivisibleBy(y));
-	EXPECT_FALSE((x.pow(2) - y.pow(2)).isDivisibleBy( x - y)) << "Only divide by monomials";
-	EXPECT_TRUE(x.isDivisibleBy(1));
-	EXPECT_FALSE(x.isDivisibleBy(0));
+	EXPECT_TRUE((this->x.pow(2) * this->y.pow(3)).isDivisibleBy(this->x));
+	EXPECT_FALSE((this->x.pow(2) * this->y.pow(3)).isDivisibleBy(this->x.pow(3)));
+	EXPECT_TRUE((2 * this->x.pow(2) * this->y - 3 * this->x * this->y.pow(2)).isDivisibleBy(this->y));
+	EXPECT_FALSE((2 * this->x.pow(2) * this->y - 3 * this->x * this->y.pow(2) + this->x).isDivisibleBy(this->y));
+	EXPECT_FALSE((this->x.pow(2) - this->y.pow(2)).isDivisibleBy( this->x - this->y)) << "Only divide by monomials";
+	EXPECT_TRUE(this->x.isDivisibleBy(1));
+	EXPECT_FALSE(this->x.isDivisibleBy(0));
 }
 
 TYPED_TEST(PolynomialTest, DivisionTest)
 {
-	EXPECT_EQ((x.pow(2) * y.pow(3)) / x, x * y.pow(3));
-	EXPECT_THROW((x.pow(2) * y.pow(3)) / x.pow(3), std::exception);
-	EXPECT_EQ((2 * x.pow(2) * y - 3 * x * y.pow(2))/y, 2 * x.pow(2) - 3 * x * y);
-	EXPECT_EQ(x / 1, x);
+	EXPECT_EQ((this->x.pow(2) * this->y.pow(3)) / this->x, this->x * this->y.pow(3));
+	EXPECT_THROW((this->x.pow(2) * this->y.pow(3)) / this->x.pow(3), std::exception);
+	EXPECT_EQ((2 * this->x.pow(2) * this->y - 3 * this->x * this->y.pow(2))/this->y, 2 * this->x.pow(2) - 3 * this->x * this->y);
+	EXPECT_EQ(this->x / 1, this->x);
 }
 
 TYPED_TEST(PolynomialTest, LeadingPowerProductTest)
 {
-	EXPECT_EQ(x.leadingPower(lex), PowerProduct(0));
+	EXPECT_EQ(this->x.leadingPower(this->lex), PowerProduct(0));
 	EXPECT_EQ(
-		(2 * x.pow(2) * y + x * y.pow(3)).leadingPower(lex), 
+		(2 * this->x.pow(2) * this->y + this->x * this->y.pow(3)).leadingPower(this->lex), 
 		PowerProduct(0).pow(2)*PowerProduct(1)
 	);
 	EXPECT_EQ(
-		(2 * x.pow(2) * y + x * y.pow(3)).leadingPower(deglex), //dynamic term order
+		(2 * this->x.pow(2) * this->y + this->x * this->y.pow(3)).leadingPower(this->deglex), //dynamic term order
 		PowerProduct(0) * PowerProduct(1).pow(3)
 	); 
-	EXPECT_THROW(P(0).leadingPower(lex),std::exception);
+	EXPECT_THROW(typename TestFixture::P(0).leadingPower(this->lex),std::exception);
 }
 
 TYPED_TEST(PolynomialTest, LeadingCoefTest)
 {
-	EXPECT_EQ(x.leadingCoef(lex), 1);
-	EXPECT_EQ((2 * x.pow(2) * y + x * y.pow(3)).leadingCoef(lex), 2);
-	EXPECT_EQ((2 * x.pow(2) * y + x * y.pow(3)).leadingCoef(deglex), 1);
-	EXPECT_EQ(P(0).leadingCoef(lex), 0);
+	EXPECT_EQ(this->x.leadingCoef(this->lex), 1);
+	EXPECT_EQ((2 * this->x.pow(2) * this->y + this->x * this->y.pow(3)).leadingCoef(this->lex), 2);
+	EXPECT_EQ((2 * this->x.pow(2) * this->y + this->x * this->y.pow(3)).leadingCoef(this->deglex), 1);
+	EXPECT_EQ(typename TestFixture::P(0).leadingCoef(this->lex), 0);
 }
 
 TYPED_TEST(PolynomialTest, LeadingTermTest)
 {
-	EXPECT_EQ((x + y).leadingTerm(lex), x);
-	EXPECT_EQ((x.pow(3) * y.pow(2) - 2 * x.pow(3) * y.pow(3) + 5 * x * y).leadingTerm(lex),
-		-2 * x.pow(3) * y.pow(3));
-	EXPECT_EQ((x.pow(3) * y.pow(2) - 2 * x * y.pow(5) + 5 * x * y).leadingTerm(deglex),
-		-2 * x * y.pow(5)
+	EXPECT_EQ((this->x + this->y).leadingTerm(this->lex), this->x);
+	EXPECT_EQ((this->x.pow(3) * this->y.pow(2) - 2 * this->x.pow(3) * this->y.pow(3) + 5 * this->x * this->y).leadingTerm(this->lex),
+		-2 * this->x.pow(3) * this->y.pow(3));
+	EXPECT_EQ((this->x.pow(3) * this->y.pow(2) - 2 * this->x * this->y.pow(5) + 5 * this->x * this->y).leadingTerm(this->deglex),
+		-2 * this->x * this->y.pow(5)
 	);
-	EXPECT_EQ(P(1).leadingTerm(lex), 1);
-	EXPECT_EQ(P(0).leadingTerm(lex), 0);
+	EXPECT_EQ(typename TestFixture::P(1).leadingTerm(this->lex), 1);
+	EXPECT_EQ(typename TestFixture::P(0).leadingTerm(this->lex), 0);
+}
+
+TYPED_TEST(PolynomialTest, TermsTest)
+{
+	typename TestFixture::P p = 2 * this->x.pow(2) * this->y - 3 * this->y + 1;
+	EXPECT_EQ(p.size(), 3u);
+	EXPECT_EQ(p.coefficient(PowerProduct(1)), -3);
+	EXPECT_EQ(p.coefficient(PowerProduct(0)), 0);
+	typename TestFixture::P sum;
+	for (const auto& term : p)
+		sum += term.second * typename TestFixture::P(term.first);
+	EXPECT_EQ(sum, p);
 }
\ No newline at end of file
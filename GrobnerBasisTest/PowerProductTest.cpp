@@ -51,4 +51,26 @@ TEST_F(PowerProductTest, LCMTest)
 {
 	EXPECT_EQ(powerProduct({ 1,2 }).lcm(powerProduct({ 2, 1 })), powerProduct({2,2}));
 	EXPECT_EQ(powerProduct({}).lcm(powerProduct({ 1,2,3 })), powerProduct({ 1,2,3 }));
-}
\ No newline at end of file
+}
+
+TEST_F(PowerProductTest, CoprimeTest)
+{
+	EXPECT_TRUE(powerProduct({ 1,0,2 }).isCoprimeTo(powerProduct({ 0,3 })));
+	EXPECT_TRUE(powerProduct({}).isCoprimeTo(powerProduct({ 1,2,3 })));
+	EXPECT_FALSE(powerProduct({ 1,0,2 }).isCoprimeTo(powerProduct({ 0,3,1 })));
+	EXPECT_FALSE(powerProduct({ 1 }).isCoprimeTo(powerProduct({ 1 })));
+}
+
+TEST_F(PowerProductTest, DegreeTest)
+{
+	EXPECT_EQ(powerProduct({}).degree(), 0);
+	EXPECT_EQ(powerProduct({ 1,0,3 }).degree(), 4);
+}
+
+TEST_F(PowerProductTest, VariableDegreeTest)
+{
+	EXPECT_EQ(powerProduct({ 1,0,3 }).degree(2), 3);
+	EXPECT_EQ(powerProduct({ 1,0,3 }).degree(5), 0);
+	EXPECT_EQ(powerProduct({ 1,0,3 }).variables(), 3u);
+	EXPECT_EQ(powerProduct({}).variables(), 0u);
+}
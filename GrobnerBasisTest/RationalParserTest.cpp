@@ -19,4 +19,63 @@ TEST_F(RationalParserTest, ParseTest)
 	EXPECT_EQ(parser.parse("0"), 0);
 	EXPECT_EQ(parser.parse("1/2"), Rational<>(1, 2));
 	EXPECT_EQ(parser.parse("-1/2"), -Rational<>(1, 2));
-}
\ No newline at end of file
+}
+
+TEST_F(RationalParserTest, WhitespaceTest)
+{
+	EXPECT_EQ(parser.parse("  1 / 2 * x ^ 2 +\ty*x - 6 "), Rational<>(1, 2) * x.pow(2) + y * x - 6);
+	EXPECT_EQ(parser.parse("x*x*y^2 + x^2*y^2 - 3"), 2 * x.pow(2) * y.pow(2) - 3); //repeated variables and like terms
+	EXPECT_EQ(parser.parse("x - x"), 0);
+}
+
+TEST_F(RationalParserTest, ErrorTest)
+{
+	//the position of the first character that could not be parsed
+	auto errorPosition = [&](const std::string& input) -> size_t
+	{
+		try
+		{
+			parser.parse(input);
+		}
+		catch (RationalParser::ParseException& ex)
+		{
+			return ex.position();
+		}
+		return std::string::npos;
+	};
+	EXPECT_EQ(errorPosition(""), 0);
+	EXPECT_EQ(errorPosition("x + "), 4);
+	EXPECT_EQ(errorPosition("x +* y"), 3);
+	EXPECT_EQ(errorPosition("2*x*z"), 4); //unknown variable
+	EXPECT_EQ(errorPosition("x^"), 2);
+	EXPECT_EQ(errorPosition("x y"), 2);
+	EXPECT_EQ(errorPosition("1 2"), 2);
+	EXPECT_EQ(errorPosition("1/0*x"), 2);
+	EXPECT_EQ(errorPosition("99999999999*x"), 0); //too large
+	EXPECT_EQ(errorPosition("x*"), 2);
+	EXPECT_EQ(errorPosition("--x"), 1);
+	EXPECT_EQ(errorPosition("(x + y"), 6);
+	EXPECT_EQ(errorPosition("x + y)"), 5);
+	EXPECT_EQ(errorPosition("()"), 1);
+	EXPECT_EQ(errorPosition("x/y"), 2);
+	EXPECT_EQ(errorPosition("(x + y)/0"), 8);
+	EXPECT_EQ(errorPosition("(x^2000000000)^2"), 15); //exponent too large
+	EXPECT_EQ(errorPosition("x^2000000000*x^2000000000"), 12);
+	EXPECT_EQ(errorPosition(std::string(2000, '(') + "x" + std::string(2000, ')')), 1000);
+	EXPECT_THROW(parser.parse("x + $"), RationalParser::ParseException);
+}
+
+TEST_F(RationalParserTest, ExpressionTest)
+{
+	EXPECT_EQ(parser.parse("(x + y)^2"), x.pow(2) + 2 * x * y + y.pow(2));
+	EXPECT_EQ(parser.parse("-(x - y)*(x + y)"), y.pow(2) - x.pow(2));
+	EXPECT_EQ(parser.parse("2*(x + 1)^3/3 - x*2"), Rational<>(2, 3) * (x + 1).pow(3) - 2 * x);
+	EXPECT_EQ(parser.parse("(x + y)^2 - (y + x)^2"), 0);
+	EXPECT_EQ(parser.parse("((x + 1)^2 + (x + 1)^2)^2"), 4 * (x + 1).pow(4));
+	EXPECT_EQ(parser.parse("((x))"), x);
+	EXPECT_EQ(parser.parse("(x*y^2)^3*(2*x)"), 2 * x.pow(4) * y.pow(6));
+	EXPECT_EQ(parser.parse("(x + y)^0"), 1);
+	EXPECT_EQ(parser.parse("0*(x + y)^5 + 1"), 1);
+	EXPECT_EQ(parser.parse("(x - x + y)*(x + 1)"), x * y + y);
+	EXPECT_EQ(parser.parse("(x^2 + y)^20"), (x.pow(2) + y).pow(20));
+}
@@ -50,3 +50,27 @@ TEST_F(StreamPrinterTest, CustomTest)
 	EXPECT_EQ(i.toString(customPrinter), "( x )");
 	EXPECT_EQ(j.toString(customPrinter), "( x , y + 1 )");
 }
+
+TEST_F(StreamPrinterTest, PrintTest)
+{
+	//written straight into the stream, after what is already there
+	std::ostringstream ss;
+	ss << "f = ";
+	f.print(ss, customPrinter, deglex);
+	ss << "; I := ";
+	j.print(ss, customPrinter);
+	ss << "; ";
+	P().print(ss, customPrinter);
+	EXPECT_EQ(ss.str(), "f = -y^2 + x + 1; I := ( x , y + 1 ); 0");
+
+	//coefficients of 1 and -1 are only left out before variables
+	EXPECT_EQ((11 * x - y + 1).toString(customPrinter), "11*x - y + 1");
+	EXPECT_EQ((-x * y - 1).toString(customPrinter), "-x*y - 1");
+	EXPECT_EQ(P(-1).toString(customPrinter), "-1");
+	EXPECT_EQ((Q(1, 11) * y - Q(1, 2)).toString(customPrinter), "1/11*y - 1/2");
+
+	StreamPrinter<double> doublePrinter{ "x","y" };
+	Polynomial<double> u{ PowerProduct(0) };
+	EXPECT_EQ((1.5 * u.pow(2) - u + 1.0).toString(doublePrinter), "1.5*x^2 - x + 1");
+	EXPECT_EQ((-0.25 * u).toString(doublePrinter), "-0.25*x");
+}
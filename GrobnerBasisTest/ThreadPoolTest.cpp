@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/ThreadPool.h"
+#include <numeric>
+
+class ThreadPoolTest : public testing::Test
+{
+protected:
+	ThreadPool pool{ 4 };
+};
+
+TEST_F(ThreadPoolTest, SubmitTest)
+{
+	auto answer = pool.submit([]() { return 6 * 7; });
+	EXPECT_EQ(answer.get(), 42);
+	EXPECT_EQ(pool.size(), 4u);
+}
+
+TEST_F(ThreadPoolTest, ForEachTest)
+{
+	std::vector<int> squares(1000);
+	pool.forEach(squares.size(), [&](size_t i) { squares[i] = int(i * i); });
+	for (size_t i = 0; i < squares.size(); ++i)
+		EXPECT_EQ(squares[i], int(i * i));
+
+	//nested use from inside the pool must not deadlock
+	std::vector<int> sums(8);
+	pool.forEach(sums.size(), [&](size_t i)
+	{
+		std::vector<int> ones(100);
+		pool.forEach(ones.size(), [&](size_t j) { ones[j] = 1; });
+		sums[i] = std::accumulate(ones.begin(), ones.end(), 0);
+	});
+	EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0), 800);
+}
+
+TEST_F(ThreadPoolTest, ExceptionTest)
+{
+	EXPECT_THROW(pool.forEach(100, [](size_t i) { if (i == 50) throw std::runtime_error("fail"); }), std::runtime_error);
+	EXPECT_THROW(pool.submit([]() -> int { throw std::runtime_error("fail"); }).get(), std::runtime_error);
+}
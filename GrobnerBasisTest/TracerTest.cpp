@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "../GrobnerBasisLib/Tracer.h"
+#include "../GrobnerBasisLib/Ideal.h"
+#include "../GrobnerBasisLib/Rational.h"
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+class TracerTest : public testing::Test
+{
+protected:
+	std::filesystem::path file = std::filesystem::temp_directory_path() / "GrobnerBasisTest-Trace.json";
+
+	void TearDown() override { std::filesystem::remove(file); }
+
+	//the contents of the trace file
+	std::string contents()
+	{
+		std::ifstream in(file, std::ios::binary);
+		std::ostringstream ss;
+		ss << in.rdbuf();
+		return ss.str();
+	}
+
+	//the number of times s occurs in the trace file
+	size_t count(const std::string& s)
+	{
+		std::string text = contents();
+		size_t n = 0;
+		for (size_t pos = text.find(s); pos != std::string::npos; pos = text.find(s, pos + 1))
+			++n;
+		return n;
+	}
+};
+
+TEST_F(TracerTest, SpanTest)
+{
+	{
+		Tracer tracer(file);
+		Tracer::Span(&tracer, "first").arg("terms", 3).arg("zero", true);
+		std::thread([&]() { Tracer::Span(&tracer, "second").arg("degree", -2); }).join();
+		Tracer::Span inactive(nullptr, "third");
+		EXPECT_FALSE(inactive);
+		inactive.arg("terms", 1);
+	}
+	std::string text = contents();
+	EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+	EXPECT_EQ(text.substr(text.size() - 4), "\n]}\n");
+	EXPECT_NE(text.find("\"name\":\"first\",\"cat\":\"grobner\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(text.find("\"tid\":1,\"args\":{\"terms\":3,\"zero\":true}"), std::string::npos);
+	EXPECT_NE(text.find("\"tid\":2,\"args\":{\"degree\":-2}"), std::string::npos);
+	EXPECT_EQ(text.find("third"), std::string::npos);
+	EXPECT_EQ(count("\"thread_name\""), 2);
+
+	EXPECT_THROW(Tracer(file / "missing" / "trace.json"), std::system_error);
+}
+
+TEST_F(TracerTest, IdealTest)
+{
+	using P = Polynomial<Rational<>>;
+	P x{ PowerProduct(0) }, y{ PowerProduct(1) }, z{ PowerProduct(2) };
+	P gens[] = { x.pow(2) - y, x * y - z + 1, y.pow(2) - x * z + x };
+	{
+		Ideal<Rational<>> ideal;
+		ideal.setThreadCount(4);
+		ideal.setTracer(std::make_shared<Tracer>(file));
+		ideal.setGenerators(gens, gens + 3);
+		ideal.reduce(x.pow(5));
+	}
+	EXPECT_EQ(count("\"name\":\"compute basis\""), 1);
+	EXPECT_GT(count("\"name\":\"select pairs\""), 0);
+	EXPECT_EQ(count("\"name\":\"S-polynomial\""), count("\"name\":\"top-reduce\""));
+	EXPECT_GT(count("\"name\":\"insert\""), 0);
+	EXPECT_EQ(count("\"name\":\"minimize\""), 1);
+	EXPECT_EQ(count("\"name\":\"interreduce\""), 1);
+	EXPECT_GT(count("\"name\":\"reduce\""), 0);
+}